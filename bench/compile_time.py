@@ -0,0 +1,50 @@
+import os, subprocess, sys, time
+
+# Usage: python bench/compile_time.py [iterations] [-- compiler flags...]
+#
+# Times a translation unit that only includes one header, for the umbrella
+# clangpp.hpp and each subsystem header, and reports the fastest time
+# relative to the umbrella. The compiler is taken from CXX, defaulting to c++.
+# Pass the flags needed to find the clang-c headers, such as -I/usr/lib/llvm/include.
+
+root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+headers = [
+    'clangpp.hpp',
+    'clangpp/string.hpp',
+    'clangpp/location.hpp',
+    'clangpp/diagnostic.hpp',
+    'clangpp/completion.hpp',
+    'clangpp/cursor.hpp',
+    'clangpp/translation_unit.hpp',
+    'clangpp/index.hpp',
+    'clangpp/compilation_database.hpp',
+]
+
+def time_header(compiler, flags, header, iterations):
+    cmd = [compiler, '-std=c++14', '-fsyntax-only', '-I' + os.path.join(root, 'include')] + flags + ['-x', 'c++', '-']
+    source = '#include <' + header + '>\n'
+    best = None
+    for i in range(iterations):
+        start = time.perf_counter()
+        subprocess.run(cmd, input=source.encode(), check=True)
+        elapsed = time.perf_counter() - start
+        if best == None or elapsed < best: best = elapsed
+    return best
+
+def main(args):
+    iterations = 5
+    flags = []
+    if '--' in args:
+        flags = args[args.index('--')+1:]
+        args = args[0:args.index('--')]
+    if len(args) > 0: iterations = int(args[0])
+    compiler = os.environ.get('CXX', 'c++')
+    times = [(h, time_header(compiler, flags, h, iterations)) for h in headers]
+    umbrella = times[0][1]
+    print('%-34s %10s %10s' % ('header', 'ms', 'relative'))
+    for h, t in times:
+        print('%-34s %10.1f %9.2fx' % (h, t * 1000, t / umbrella))
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -0,0 +1,231 @@
+#include <clangpp.hpp>
+#include <clangpp/parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Usage: clangpp-bench-corpus [--dir DIR] [--tus N] [--headers N] [--depth N]
+//                             [--templates N] [--threads N]
+//
+// Generates a synthetic project in DIR with a compile_commands.json: a
+// lattice of headers, --depth levels of --headers headers each, where every
+// header includes two headers of the next level and defines --templates
+// class templates, and --tus sources that each include two headers of the
+// first level and instantiate their templates. The project is then run
+// through the parse, traverse and index phases, and throughput, latency
+// percentiles and peak RSS are written to stdout as JSON.
+
+struct corpus_config
+{
+    std::string dir = "clangpp-bench-corpus";
+    unsigned tus = 200;
+    unsigned headers = 16;
+    unsigned depth = 4;
+    unsigned templates = 8;
+    unsigned threads = std::thread::hardware_concurrency();
+};
+
+std::string header_name(unsigned level, unsigned i)
+{
+    return "h" + std::to_string(level) + "_" + std::to_string(i) + ".hpp";
+}
+
+void write_file(const std::string& path, const std::string& contents)
+{
+    std::ofstream os(path);
+    os << contents;
+    if (!os)
+    {
+        fprintf(stderr, "Can't write %s\n", path.c_str());
+        std::exit(1);
+    }
+}
+
+void generate(const corpus_config& c)
+{
+    mkdir(c.dir.c_str(), 0755);
+    mkdir((c.dir + "/include").c_str(), 0755);
+    mkdir((c.dir + "/src").c_str(), 0755);
+    for(unsigned level = 0; level < c.depth; level++)
+    {
+        for(unsigned i = 0; i < c.headers; i++)
+        {
+            std::string prefix = "l" + std::to_string(level) + "_" + std::to_string(i);
+            std::string s = "#pragma once\n";
+            if (level + 1 < c.depth)
+            {
+                s += "#include \"" + header_name(level + 1, i) + "\"\n";
+                s += "#include \"" + header_name(level + 1, (i + 1) % c.headers) + "\"\n";
+            }
+            s += "namespace " + prefix + " {\n";
+            for(unsigned t = 0; t < c.templates; t++)
+            {
+                std::string n = std::to_string(t);
+                s += "template<class T, int N>\nstruct box" + n + "\n{\n    T values[N];\n";
+                s += "    T sum() const\n    {\n        T result{};\n        for(int i = 0; i < N; i++) result += values[i];\n        return result;\n    }\n};\n";
+                s += "inline int compute" + n + "(int x)\n{\n    box" + n + "<int, " + std::to_string(t + 1) + "> b{};\n";
+                s += "    b.values[0] = x;\n    return b.sum() + " + n + ";\n}\n";
+            }
+            s += "}\n";
+            write_file(c.dir + "/include/" + header_name(level, i), s);
+        }
+    }
+    std::string db = "[\n";
+    for(unsigned k = 0; k < c.tus; k++)
+    {
+        unsigned a = k % c.headers;
+        unsigned b = (k + 1) % c.headers;
+        std::string s;
+        s += "#include \"" + header_name(0, a) + "\"\n";
+        s += "#include \"" + header_name(0, b) + "\"\n";
+        s += "int tu" + std::to_string(k) + "(int x)\n{\n    int result = 0;\n";
+        for(unsigned t = 0; t < c.templates; t++)
+        {
+            std::string n = std::to_string(t);
+            s += "    result += l0_" + std::to_string(a) + "::compute" + n + "(x);\n";
+            s += "    result += l0_" + std::to_string(b) + "::box" + n + "<long, " + std::to_string(k % 7 + 1) + ">{}.sum();\n";
+        }
+        s += "    return result;\n}\n";
+        std::string file = "src/tu" + std::to_string(k) + ".cpp";
+        write_file(c.dir + "/" + file, s);
+        if (k > 0) db += ",\n";
+        db += "  {\"directory\": \"" + c.dir + "\", \"file\": \"" + file + "\", ";
+        db += "\"arguments\": [\"clang++\", \"-std=c++14\", \"-Iinclude\", \"-c\", \"" + file + "\"]}";
+    }
+    db += "\n]\n";
+    write_file(c.dir + "/compile_commands.json", db);
+}
+
+struct phase_result
+{
+    const char * name;
+    std::size_t failures = 0;
+    double seconds = 0;
+    std::vector<double> latencies;
+};
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    std::size_t i = p * (sorted.size() - 1) + 0.5;
+    return sorted[i];
+}
+
+// Runs f(idx, job) for every job on a pool of threads, timing each call
+template<class F>
+phase_result run_phase(const char * name, const std::vector<clang::parse_job>& jobs, unsigned threads, F f)
+{
+    phase_result result;
+    result.name = name;
+    result.latencies.resize(jobs.size(), -1);
+    std::atomic<std::size_t> failures{0};
+    clang::index_pool pool;
+    auto start = std::chrono::steady_clock::now();
+    clang::detail::parallel_for(jobs.size(), threads, [&](unsigned, std::size_t i)
+    {
+        auto job_start = std::chrono::steady_clock::now();
+        try
+        {
+            f(pool.get(), jobs[i]);
+        }
+        catch(const clang::exception&)
+        {
+            failures++;
+            return;
+        }
+        result.latencies[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job_start).count();
+    });
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.failures = failures;
+    result.latencies.erase(std::remove(result.latencies.begin(), result.latencies.end(), -1), result.latencies.end());
+    std::sort(result.latencies.begin(), result.latencies.end());
+    return result;
+}
+
+int main(int argc, char const *argv[])
+{
+    corpus_config c;
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string flag = argv[i];
+        unsigned n = std::max(1, std::atoi(argv[i+1]));
+        if (flag == "--dir") c.dir = argv[i+1];
+        else if (flag == "--tus") c.tus = n;
+        else if (flag == "--headers") c.headers = n;
+        else if (flag == "--depth") c.depth = n;
+        else if (flag == "--templates") c.templates = n;
+        else if (flag == "--threads") c.threads = n;
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (c.dir.empty() || c.dir[0] != '/')
+    {
+        char cwd[4096];
+        if (getcwd(cwd, sizeof(cwd)) != nullptr) c.dir = std::string(cwd) + "/" + c.dir;
+    }
+    generate(c);
+    auto jobs = clang::get_parse_jobs(clang::compilation_database{c.dir});
+
+    std::vector<phase_result> phases;
+    phases.push_back(run_phase("parse", jobs, c.threads, [](clang::index& idx, const clang::parse_job& job)
+    {
+        clang::parse_job_translation_unit(idx, job, CXTranslationUnit_None);
+    }));
+    phases.push_back(run_phase("traverse", jobs, c.threads, [](clang::index& idx, const clang::parse_job& job)
+    {
+        auto tu = clang::parse_job_translation_unit(idx, job, CXTranslationUnit_None);
+        for(auto c:tu.get_translation_unit_cursor().descendants()) c.get_kind();
+    }));
+    phases.push_back(run_phase("index", jobs, c.threads, [](clang::index& idx, const clang::parse_job& job)
+    {
+        auto tu = clang::parse_job_translation_unit(idx, job, CXTranslationUnit_None);
+        std::size_t n = 0;
+        IndexerCallbacks callbacks = {};
+        callbacks.indexDeclaration = [](CXClientData data, const CXIdxDeclInfo *)
+        {
+            (*reinterpret_cast<std::size_t*>(data))++;
+        };
+        callbacks.indexEntityReference = [](CXClientData data, const CXIdxEntityRefInfo *)
+        {
+            (*reinterpret_cast<std::size_t*>(data))++;
+        };
+        auto action = idx.create();
+        action.index_translation_unit(&n, &callbacks, sizeof(callbacks), CXIndexOpt_None, tu);
+    }));
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("{\n  \"config\": {\"tus\": %u, \"headers\": %u, \"depth\": %u, \"templates\": %u, \"threads\": %u},\n",
+        c.tus, c.headers, c.depth, c.templates, c.threads);
+    printf("  \"phases\": [\n");
+    for(std::size_t i = 0; i < phases.size(); i++)
+    {
+        auto&& p = phases[i];
+        auto&& l = p.latencies;
+        printf("    {\"name\": \"%s\", \"files\": %zu, \"failures\": %zu, \"seconds\": %.3f, \"files_per_second\": %.2f, ",
+            p.name, l.size(), p.failures, p.seconds, p.seconds > 0 ? l.size() / p.seconds : 0.0);
+        printf("\"latency_ms\": {\"p50\": %.2f, \"p90\": %.2f, \"p99\": %.2f, \"max\": %.2f}}%s\n",
+            percentile(l, 0.5), percentile(l, 0.9), percentile(l, 0.99), l.empty() ? 0.0 : l.back(), i + 1 < phases.size() ? "," : "");
+    }
+    printf("  ],\n");
+    // ru_maxrss is in KiB on Linux and in bytes on macOS
+#ifdef __APPLE__
+    printf("  \"peak_rss_kib\": %ld\n}\n", long(usage.ru_maxrss / 1024));
+#else
+    printf("  \"peak_rss_kib\": %ld\n}\n", long(usage.ru_maxrss));
+#endif
+}
@@ -0,0 +1,71 @@
+#include <clangpp.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Usage: clangpp-bench-profiles <file> [iterations] [-- compiler args...]
+//
+// Parses the file with every parse_profile and reports the fastest parse
+// time and the memory held by the translation unit, relative to the full
+// profile.
+int main(int argc, char const *argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s <file> [iterations] [-- compiler args...]\n", argv[0]);
+        return 1;
+    }
+    std::string file = argv[1];
+    int iterations = 5;
+    std::vector<const char *> args;
+    for(int i = 2; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--") == 0)
+        {
+            args.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        iterations = std::max(1, std::atoi(argv[i]));
+    }
+
+    struct profile_result
+    {
+        const char * name;
+        clang::parse_profile profile;
+        double ms;
+        unsigned long memory;
+    };
+    std::vector<profile_result> results = {
+        {"full", clang::parse_profile::full, 0, 0},
+        {"editing", clang::parse_profile::editing, 0, 0},
+        {"declarations_only", clang::parse_profile::declarations_only, 0, 0},
+        {"lexical_only", clang::parse_profile::lexical_only, 0, 0},
+    };
+
+    clang::index idx{0, 0};
+    for(auto&& r:results)
+    {
+        r.ms = -1;
+        for(int i = 0; i < iterations; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto tu = idx.parse_translation_unit(file, r.profile, args);
+            auto stop = std::chrono::steady_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+            if (r.ms < 0 || ms < r.ms) r.ms = ms;
+            r.memory = tu.get_memory_usage();
+        }
+    }
+
+    auto&& full = results.front();
+    printf("%-20s %12s %8s %14s %8s\n", "profile", "time (ms)", "speedup", "memory (KiB)", "memory");
+    for(auto&& r:results)
+    {
+        printf("%-20s %12.2f %7.2fx %14lu %7.0f%%\n", 
+            r.name, r.ms, full.ms / r.ms, r.memory / 1024, 100.0 * r.memory / full.memory);
+    }
+}
@@ -2,6 +2,36 @@ import sys, re
 
 fnames = sys.argv[1:]
 
+# With --cursor-kinds, prints the CLANGPP_CURSOR_KINDS table used by
+# ast_visitor from the CXCursorKind enumeration instead
+non_local_decls = ['Namespace', 'LinkageSpec', 'FunctionTemplate', 'ClassTemplate', 'ClassTemplatePartialSpecialization', 'ModuleImportDecl', 'TypeAliasTemplateDecl']
+
+def get_cursor_category(name, value):
+    if value < 40 or 600 <= value < 700:
+        if name in non_local_decls: return 'decl'
+        return 'local_decl'
+    if value < 70: return 'ref'
+    if 100 <= value < 200: return 'expr'
+    if 200 <= value < 300: return 'stmt'
+    if 400 <= value < 500: return 'attr'
+    if 500 <= value < 600: return 'preprocessing'
+    return None
+
+def generate_cursor_kinds(fname):
+    with open(fname) as f:
+        text = f.read()
+    body = text[text.find('enum CXCursorKind'):]
+    body = body[body.find('{')+1:body.find('};')]
+    body = re.sub(r'/\*.*?\*/', '', body, flags=re.S)
+    rows = []
+    for name, value in re.findall(r'CXCursor_(\w+)\s*=\s*(\d+)', body):
+        if name.startswith('First') or name.startswith('Last') or name.startswith('ObjC') or name.startswith('OMP'): continue
+        category = get_cursor_category(name, int(value))
+        if category == None: continue
+        rows.append('    X(' + name + ', ' + to_snake_case(name) + ', ' + category + ')')
+    print('#define CLANGPP_CURSOR_KINDS(X) \\\n' + ' \\\n'.join(rows))
+
+
 decls = []
 
 class_map = {}
@@ -52,14 +82,17 @@ def forward_param(type, name):
 def generate_fun_params(decl):
     return gen_params(decl['params'], lambda x, y: x + ' ' + y)
 
+def traced(name):
+    return 'CLANGPP_CALL(' + name + ')'
+
 def generate_forward_params(decl):
-    return decl['name'] + gen_params(decl['params'], forward_param)
+    return traced(decl['name']) + gen_params(decl['params'], forward_param)
 
 def generate_fun_self_params(decl):
     return gen_params(decl['params'][1:], lambda x, y: x + ' ' + y)
 
 def generate_forward_self_params(decl):
-    return decl['name'] + gen_params([{'name': 'self', 'type': 'Self'}] + decl['params'][1:], forward_param)
+    return traced(decl['name']) + gen_params([{'name': 'self', 'type': 'Self'}] + decl['params'][1:], forward_param)
 
 class CppClass:
     def __init__(self, type, name=None):
@@ -98,7 +131,7 @@ class CppClass:
             result.append(self.name + '& operator=(const ' + self.name + '&)=delete;')
             result.append('~' + self.name + '()')
             result.append('{')
-            result.append('    ' + self.destructor['name'] + '(self);')
+            result.append('    ' + traced(self.destructor['name']) + '(self);')
             result.append('}')
 
         for f in self.functions:
@@ -113,6 +146,10 @@ class CppClass:
         return '\n'.join(['struct ' + self.name, '{'] + [('    ' + x) for x in result] + ['};'])
 
 
+if len(fnames) > 1 and fnames[0] == '--cursor-kinds':
+    generate_cursor_kinds(fnames[1])
+    sys.exit(0)
+
 for fname in fnames:
     with open(fname) as f:
         current_decl = ''
@@ -284,4 +321,3 @@ for decl in decls:
 
 for c in classes:
     print(c.generate())
-    
\ No newline at end of file
@@ -0,0 +1,233 @@
+#ifndef LIBCLANGPP_AST_VISITOR_H
+#define LIBCLANGPP_AST_VISITOR_H
+
+#include <clangpp/cursor.hpp>
+#include <type_traits>
+
+// The cursor kinds with a hook in ast_visitor, as (kind, hook, category).
+// Generated with `python generate.py --cursor-kinds clang-c/Index.h`, keeping
+// the kinds available in every supported version of libclang.
+#define CLANGPP_CURSOR_KINDS(X) \
+    X(UnexposedDecl, unexposed_decl, local_decl) \
+    X(StructDecl, struct_decl, local_decl) \
+    X(UnionDecl, union_decl, local_decl) \
+    X(ClassDecl, class_decl, local_decl) \
+    X(EnumDecl, enum_decl, local_decl) \
+    X(FieldDecl, field_decl, local_decl) \
+    X(EnumConstantDecl, enum_constant_decl, local_decl) \
+    X(FunctionDecl, function_decl, local_decl) \
+    X(VarDecl, var_decl, local_decl) \
+    X(ParmDecl, parm_decl, local_decl) \
+    X(TypedefDecl, typedef_decl, local_decl) \
+    X(CXXMethod, cxx_method, local_decl) \
+    X(Namespace, namespace, decl) \
+    X(LinkageSpec, linkage_spec, decl) \
+    X(Constructor, constructor, local_decl) \
+    X(Destructor, destructor, local_decl) \
+    X(ConversionFunction, conversion_function, local_decl) \
+    X(TemplateTypeParameter, template_type_parameter, local_decl) \
+    X(NonTypeTemplateParameter, non_type_template_parameter, local_decl) \
+    X(TemplateTemplateParameter, template_template_parameter, local_decl) \
+    X(FunctionTemplate, function_template, decl) \
+    X(ClassTemplate, class_template, decl) \
+    X(ClassTemplatePartialSpecialization, class_template_partial_specialization, decl) \
+    X(NamespaceAlias, namespace_alias, local_decl) \
+    X(UsingDirective, using_directive, local_decl) \
+    X(UsingDeclaration, using_declaration, local_decl) \
+    X(TypeAliasDecl, type_alias_decl, local_decl) \
+    X(CXXAccessSpecifier, cxx_access_specifier, local_decl) \
+    X(TypeRef, type_ref, ref) \
+    X(CXXBaseSpecifier, cxx_base_specifier, ref) \
+    X(TemplateRef, template_ref, ref) \
+    X(NamespaceRef, namespace_ref, ref) \
+    X(MemberRef, member_ref, ref) \
+    X(LabelRef, label_ref, ref) \
+    X(OverloadedDeclRef, overloaded_decl_ref, ref) \
+    X(VariableRef, variable_ref, ref) \
+    X(UnexposedExpr, unexposed_expr, expr) \
+    X(DeclRefExpr, decl_ref_expr, expr) \
+    X(MemberRefExpr, member_ref_expr, expr) \
+    X(CallExpr, call_expr, expr) \
+    X(IntegerLiteral, integer_literal, expr) \
+    X(FloatingLiteral, floating_literal, expr) \
+    X(ImaginaryLiteral, imaginary_literal, expr) \
+    X(StringLiteral, string_literal, expr) \
+    X(CharacterLiteral, character_literal, expr) \
+    X(ParenExpr, paren_expr, expr) \
+    X(UnaryOperator, unary_operator, expr) \
+    X(ArraySubscriptExpr, array_subscript_expr, expr) \
+    X(BinaryOperator, binary_operator, expr) \
+    X(CompoundAssignOperator, compound_assign_operator, expr) \
+    X(ConditionalOperator, conditional_operator, expr) \
+    X(CStyleCastExpr, c_style_cast_expr, expr) \
+    X(CompoundLiteralExpr, compound_literal_expr, expr) \
+    X(InitListExpr, init_list_expr, expr) \
+    X(AddrLabelExpr, addr_label_expr, expr) \
+    X(StmtExpr, stmt_expr, expr) \
+    X(GenericSelectionExpr, generic_selection_expr, expr) \
+    X(GNUNullExpr, gnu_null_expr, expr) \
+    X(CXXStaticCastExpr, cxx_static_cast_expr, expr) \
+    X(CXXDynamicCastExpr, cxx_dynamic_cast_expr, expr) \
+    X(CXXReinterpretCastExpr, cxx_reinterpret_cast_expr, expr) \
+    X(CXXConstCastExpr, cxx_const_cast_expr, expr) \
+    X(CXXFunctionalCastExpr, cxx_functional_cast_expr, expr) \
+    X(CXXTypeidExpr, cxx_typeid_expr, expr) \
+    X(CXXBoolLiteralExpr, cxx_bool_literal_expr, expr) \
+    X(CXXNullPtrLiteralExpr, cxx_null_ptr_literal_expr, expr) \
+    X(CXXThisExpr, cxx_this_expr, expr) \
+    X(CXXThrowExpr, cxx_throw_expr, expr) \
+    X(CXXNewExpr, cxx_new_expr, expr) \
+    X(CXXDeleteExpr, cxx_delete_expr, expr) \
+    X(UnaryExpr, unary_expr, expr) \
+    X(PackExpansionExpr, pack_expansion_expr, expr) \
+    X(SizeOfPackExpr, size_of_pack_expr, expr) \
+    X(LambdaExpr, lambda_expr, expr) \
+    X(UnexposedStmt, unexposed_stmt, stmt) \
+    X(LabelStmt, label_stmt, stmt) \
+    X(CompoundStmt, compound_stmt, stmt) \
+    X(CaseStmt, case_stmt, stmt) \
+    X(DefaultStmt, default_stmt, stmt) \
+    X(IfStmt, if_stmt, stmt) \
+    X(SwitchStmt, switch_stmt, stmt) \
+    X(WhileStmt, while_stmt, stmt) \
+    X(DoStmt, do_stmt, stmt) \
+    X(ForStmt, for_stmt, stmt) \
+    X(GotoStmt, goto_stmt, stmt) \
+    X(IndirectGotoStmt, indirect_goto_stmt, stmt) \
+    X(ContinueStmt, continue_stmt, stmt) \
+    X(BreakStmt, break_stmt, stmt) \
+    X(ReturnStmt, return_stmt, stmt) \
+    X(GCCAsmStmt, gcc_asm_stmt, stmt) \
+    X(CXXCatchStmt, cxx_catch_stmt, stmt) \
+    X(CXXTryStmt, cxx_try_stmt, stmt) \
+    X(CXXForRangeStmt, cxx_for_range_stmt, stmt) \
+    X(NullStmt, null_stmt, stmt) \
+    X(DeclStmt, decl_stmt, stmt) \
+    X(UnexposedAttr, unexposed_attr, attr) \
+    X(CXXFinalAttr, cxx_final_attr, attr) \
+    X(CXXOverrideAttr, cxx_override_attr, attr) \
+    X(AnnotateAttr, annotate_attr, attr) \
+    X(AsmLabelAttr, asm_label_attr, attr) \
+    X(PackedAttr, packed_attr, attr) \
+    X(PureAttr, pure_attr, attr) \
+    X(ConstAttr, const_attr, attr) \
+    X(PreprocessingDirective, preprocessing_directive, preprocessing) \
+    X(MacroDefinition, macro_definition, preprocessing) \
+    X(MacroExpansion, macro_expansion, preprocessing) \
+    X(InclusionDirective, inclusion_directive, preprocessing) \
+    X(ModuleImportDecl, module_import_decl, decl) \
+    X(TypeAliasTemplateDecl, type_alias_template_decl, decl) \
+    X(StaticAssert, static_assert, local_decl)
+
+namespace clang {
+
+namespace detail {
+
+// Declarations that can not appear in a function body are decl; everything
+// that can is local_decl
+enum class cursor_category
+{
+    decl,
+    local_decl,
+    ref,
+    expr,
+    stmt,
+    attr,
+    preprocessing
+};
+
+template<class D, class C>
+CXChildVisitResult invoke_ast_hook(D& d, void (C::*f)(cursor), cursor c)
+{
+    (d.*f)(c);
+    return CXChildVisit_Recurse;
+}
+
+template<class D, class C>
+CXChildVisitResult invoke_ast_hook(D& d, CXChildVisitResult (C::*f)(cursor), cursor c)
+{
+    return (d.*f)(c);
+}
+
+}
+
+// Visits the descendants of a cursor, calling the on_<kind> hook of Derived
+// for each cursor of that kind. Hooks take a cursor and return either void,
+// to visit the children, or a CXChildVisitResult. Only the hooks Derived
+// defines are dispatched to, through a switch generated from
+// CLANGPP_CURSOR_KINDS, and statements and expressions are not entered when
+// no hook could match inside them. Declarations that can be local, such as
+// variables and functions, count as matching inside function bodies; a
+// visitor that does not care about local declarations can hide visits_code
+// with one that returns false to skip the bodies anyway.
+template<class Derived>
+struct ast_visitor
+{
+#define CLANGPP_AST_VISITOR_HOOK(kind, name, category) \
+    void on_##name(cursor) {} \
+    static constexpr bool overrides_##name() \
+    { \
+        return !std::is_same<decltype(&Derived::on_##name), decltype(&ast_visitor::on_##name)>::value; \
+    }
+    CLANGPP_CURSOR_KINDS(CLANGPP_AST_VISITOR_HOOK)
+#undef CLANGPP_AST_VISITOR_HOOK
+
+#define CLANGPP_AST_VISITOR_INSIDE_CODE(kind, name, category) \
+    || (detail::cursor_category::category != detail::cursor_category::decl && \
+        detail::cursor_category::category != detail::cursor_category::preprocessing && overrides_##name())
+    // Whether a hook could match inside a statement or expression
+    static constexpr bool visits_code()
+    {
+        return false CLANGPP_CURSOR_KINDS(CLANGPP_AST_VISITOR_INSIDE_CODE);
+    }
+#undef CLANGPP_AST_VISITOR_INSIDE_CODE
+
+#define CLANGPP_AST_VISITOR_INSIDE_DECL(kind, name, category) \
+    || (detail::cursor_category::category != detail::cursor_category::preprocessing && overrides_##name())
+    // Whether a hook could match below the top level; preprocessing cursors
+    // only appear at the top level
+    static constexpr bool visits_declarations()
+    {
+        return false CLANGPP_CURSOR_KINDS(CLANGPP_AST_VISITOR_INSIDE_DECL);
+    }
+#undef CLANGPP_AST_VISITOR_INSIDE_DECL
+
+    unsigned visit(cursor root)
+    {
+        return root.visit_children([this](cursor c, cursor)
+        {
+            return this->dispatch(c);
+        });
+    }
+
+    CXChildVisitResult dispatch(cursor c)
+    {
+        auto kind = c.get_kind();
+        auto result = CXChildVisit_Recurse;
+        switch(kind)
+        {
+#define CLANGPP_AST_VISITOR_CASE(kind, name, category) \
+            case CXCursor_##kind: \
+                if (overrides_##name()) result = detail::invoke_ast_hook(derived(), &Derived::on_##name, c); \
+                break;
+            CLANGPP_CURSOR_KINDS(CLANGPP_AST_VISITOR_CASE)
+#undef CLANGPP_AST_VISITOR_CASE
+            default:
+                break;
+        }
+        if (result != CXChildVisit_Recurse) return result;
+        bool code = CLANGPP_CALL(clang_isExpression)(kind) || CLANGPP_CALL(clang_isStatement)(kind);
+        if (code ? !Derived::visits_code() : !Derived::visits_declarations()) return CXChildVisit_Continue;
+        return CXChildVisit_Recurse;
+    }
+
+private:
+    Derived& derived()
+    {
+        return static_cast<Derived&>(*this);
+    }
+};
+
+}
+
+#endif
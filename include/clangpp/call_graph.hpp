@@ -0,0 +1,272 @@
+#ifndef LIBCLANGPP_CALL_GRAPH_H
+#define LIBCLANGPP_CALL_GRAPH_H
+
+#include <clangpp/cursor.hpp>
+#include <clangpp/translation_unit.hpp>
+#include <clangpp/parallel.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace clang {
+
+const std::uint32_t call_graph_npos = std::uint32_t(-1);
+
+// A call graph in compressed sparse row form: the callees of node n are
+// targets[offsets[n]] to targets[offsets[n+1]], sorted and without
+// duplicates. Nodes are functions, identified by their USR.
+struct call_graph
+{
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> targets;
+    // Null-terminated USRs, with names[n] the offset of the USR of node n
+    std::string strings;
+    std::vector<std::uint32_t> names;
+    // Nodes sorted by USR, for find
+    std::vector<std::uint32_t> by_usr;
+
+    call_graph() : offsets(1, 0)
+    {}
+
+    std::size_t node_count() const
+    {
+        return names.size();
+    }
+
+    std::size_t edge_count() const
+    {
+        return targets.size();
+    }
+
+    const char * get_usr(std::uint32_t n) const
+    {
+        return strings.c_str() + names[n];
+    }
+
+    auto get_callees(std::uint32_t n) const
+    {
+        return detail::make_iterator_range(targets.data() + offsets[n], targets.data() + offsets[n+1]);
+    }
+
+    // Returns the node with the usr, or call_graph_npos
+    std::uint32_t find(string_view usr) const
+    {
+        auto it = std::lower_bound(by_usr.begin(), by_usr.end(), usr.c_str(), [&](std::uint32_t n, const char * s)
+        {
+            return std::strcmp(get_usr(n), s) < 0;
+        });
+        if (it == by_usr.end() || std::strcmp(get_usr(*it), usr.c_str()) != 0) return call_graph_npos;
+        return *it;
+    }
+
+    // The graph with every edge reversed, so the callees of a node are its callers
+    call_graph transpose() const
+    {
+        call_graph result;
+        result.strings = strings;
+        result.names = names;
+        result.by_usr = by_usr;
+        result.offsets.assign(node_count() + 1, 0);
+        for(auto t:targets) result.offsets[t + 1]++;
+        for(std::size_t n = 0; n < node_count(); n++) result.offsets[n + 1] += result.offsets[n];
+        result.targets.resize(targets.size());
+        auto next = result.offsets;
+        for(std::uint32_t n = 0; n < node_count(); n++)
+        {
+            for(auto t:get_callees(n)) result.targets[next[t]++] = n;
+        }
+        return result;
+    }
+
+    // Marks every node reachable from the roots, including the roots
+    std::vector<bool> get_reachable(const std::vector<std::uint32_t>& roots) const
+    {
+        std::vector<bool> result(node_count(), false);
+        std::vector<std::uint32_t> stack;
+        for(auto r:roots)
+        {
+            if (r == call_graph_npos || result[r]) continue;
+            result[r] = true;
+            stack.push_back(r);
+        }
+        while(!stack.empty())
+        {
+            auto n = stack.back();
+            stack.pop_back();
+            for(auto t:get_callees(n))
+            {
+                if (result[t]) continue;
+                result[t] = true;
+                stack.push_back(t);
+            }
+        }
+        return result;
+    }
+};
+
+namespace detail {
+
+inline bool is_function_kind(CXCursorKind kind)
+{
+    switch(kind)
+    {
+        case CXCursor_FunctionDecl:
+        case CXCursor_FunctionTemplate:
+        case CXCursor_CXXMethod:
+        case CXCursor_Constructor:
+        case CXCursor_Destructor:
+        case CXCursor_ConversionFunction:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The calls found in one translation unit, with USRs numbered locally so the
+// shared builder is only locked once per translation unit
+struct tu_calls
+{
+    std::vector<std::string> usrs;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    // Callees seen so far, so the USR of each is computed once
+    std::unordered_map<unsigned, std::vector<std::pair<cursor, std::uint32_t>>> ids;
+
+    std::uint32_t add(std::string usr)
+    {
+        usrs.push_back(std::move(usr));
+        return usrs.size() - 1;
+    }
+
+    std::uint32_t get_id(cursor c)
+    {
+        auto&& bucket = ids[c.hash()];
+        for(auto&& p:bucket)
+        {
+            if (p.first.equal_cursors(c)) return p.second;
+        }
+        auto usr = c.get_usr().to_std_string();
+        auto id = usr.empty() ? call_graph_npos : add(std::move(usr));
+        bucket.emplace_back(c, id);
+        return id;
+    }
+};
+
+struct call_graph_builder
+{
+    std::mutex m;
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    // Function definitions already walked, since definitions in headers are
+    // seen by every translation unit that includes them
+    std::unordered_set<std::string> defined;
+
+    bool claim(const std::string& usr)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return defined.insert(usr).second;
+    }
+
+    std::uint32_t get_node(const std::string& usr)
+    {
+        return ids.emplace(usr, ids.size()).first->second;
+    }
+
+    void merge(const tu_calls& calls)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        std::vector<std::uint32_t> global;
+        global.reserve(calls.usrs.size());
+        for(auto&& usr:calls.usrs) global.push_back(get_node(usr));
+        for(auto&& e:calls.edges) edges.emplace_back(global[e.first], global[e.second]);
+    }
+
+    void collect(translation_unit& tu, tu_calls& calls)
+    {
+        tu.get_translation_unit_cursor().visit_children([&](cursor c, cursor)
+        {
+            if (c.get_location().is_in_system_header()) return CXChildVisit_Continue;
+            if (!is_function_kind(c.get_kind())) return CXChildVisit_Recurse;
+            if (!c.is_definition()) return CXChildVisit_Continue;
+            auto usr = c.get_usr().to_std_string();
+            if (usr.empty() || !claim(usr)) return CXChildVisit_Continue;
+            auto caller = calls.add(std::move(usr));
+            c.visit_children([&](cursor e, cursor)
+            {
+                if (e.get_kind() != CXCursor_CallExpr) return CXChildVisit_Recurse;
+                auto callee = e.get_referenced();
+                if (callee.is_null()) return CXChildVisit_Recurse;
+                auto id = calls.get_id(callee);
+                if (id != call_graph_npos) calls.edges.emplace_back(caller, id);
+                return CXChildVisit_Recurse;
+            });
+            return CXChildVisit_Continue;
+        });
+    }
+
+    call_graph finish()
+    {
+        call_graph result;
+        result.names.resize(ids.size());
+        for(auto&& p:ids)
+        {
+            result.names[p.second] = result.strings.size();
+            result.strings.append(p.first);
+            result.strings.push_back('\0');
+        }
+        result.by_usr.resize(ids.size());
+        for(std::uint32_t n = 0; n < ids.size(); n++) result.by_usr[n] = n;
+        std::sort(result.by_usr.begin(), result.by_usr.end(), [&](std::uint32_t x, std::uint32_t y)
+        {
+            return std::strcmp(result.get_usr(x), result.get_usr(y)) < 0;
+        });
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        result.offsets.assign(ids.size() + 1, 0);
+        result.targets.reserve(edges.size());
+        for(auto&& e:edges)
+        {
+            result.offsets[e.first + 1]++;
+            result.targets.push_back(e.second);
+        }
+        for(std::size_t n = 0; n < ids.size(); n++) result.offsets[n + 1] += result.offsets[n];
+        return result;
+    }
+};
+
+}
+
+// Builds the call graph of a translation unit, from every call expression in
+// a function definition outside of system headers to the function it calls.
+inline call_graph build_call_graph(translation_unit& tu)
+{
+    detail::call_graph_builder b;
+    detail::tu_calls calls;
+    b.collect(tu, calls);
+    b.merge(calls);
+    return b.finish();
+}
+
+// Builds the call graph of every job in parallel, merging functions with the
+// same USR across translation units. Functions defined in headers are only
+// walked by the first translation unit that reaches them.
+inline call_graph build_call_graph(const std::vector<parse_job>& jobs, parallel_options opts={})
+{
+    detail::call_graph_builder b;
+    parallel_parse(jobs, [&](const parse_job&, translation_unit& tu)
+    {
+        detail::tu_calls calls;
+        b.collect(tu, calls);
+        b.merge(calls);
+    }, opts);
+    return b.finish();
+}
+
+}
+
+#endif
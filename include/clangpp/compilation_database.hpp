@@ -0,0 +1,94 @@
+#ifndef LIBCLANGPP_COMPILATION_DATABASE_H
+#define LIBCLANGPP_COMPILATION_DATABASE_H
+
+#include <clangpp/string.hpp>
+#include <stdexcept>
+#include <clang-c/CXCompilationDatabase.h>
+
+namespace clang {
+
+struct compile_command
+{
+    CXCompileCommand self;
+    compile_command(CXCompileCommand s) : self(s)
+    {}
+    string get_directory()
+    {
+        return CLANGPP_CALL(clang_CompileCommand_getDirectory)(self);
+    }
+    string get_filename()
+    {
+        return CLANGPP_CALL(clang_CompileCommand_getFilename)(self);
+    }
+    auto get_args()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_CompileCommand_getNumArgs)(self), [this](int i)
+        {
+            return CLANGPP_CALL(clang_CompileCommand_getArg)(self, i);
+        });
+    }
+    auto get_mapped_sources()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_CompileCommand_getNumMappedSources)(self), [this](int i)
+        {
+            return std::make_pair(CLANGPP_CALL(clang_CompileCommand_getMappedSourcePath)(self, i), CLANGPP_CALL(clang_CompileCommand_getMappedSourceContent)(self, i));
+        });
+    }
+};
+struct compile_commands
+{
+    CLANGPP_UNIQUE_PTR(CXCompileCommands, clang_CompileCommands_dispose) self;
+    compile_commands(CXCompileCommands s) : self(s)
+    {}
+    unsigned size() const
+    {
+        return CLANGPP_CALL(clang_CompileCommands_getSize)(self.get());
+    }
+    compile_command operator()(unsigned i) const
+    {
+        return CLANGPP_CALL(clang_CompileCommands_getCommand)(self.get(), i);
+    }
+
+    using iterator = detail::iota_iterator<const compile_commands>;
+    using const_iterator = detail::iota_iterator<const compile_commands>;
+
+    iterator begin() const
+    {
+        return iterator(0, *this);
+    }
+
+    iterator end() const
+    {
+        return iterator(size(), *this);
+    }
+};
+struct compilation_database
+{
+    using self_ptr = CLANGPP_UNIQUE_PTR(CXCompilationDatabase, clang_CompilationDatabase_dispose);
+    self_ptr self;
+    compilation_database(string_view build_dir) : self(nullptr)
+    {
+        CXCompilationDatabase_Error error_code;
+        self = self_ptr(CLANGPP_CALL(clang_CompilationDatabase_fromDirectory)(build_dir.c_str(), &error_code));
+        if (error_code != CXCompilationDatabase_Error::CXCompilationDatabase_NoError)
+        {
+            throw std::runtime_error("Database can't be loaded");
+        }
+    }
+    compile_commands operator[](string_view complete_file_name) const
+    {
+        return this->get_compile_commands(complete_file_name);
+    }
+    compile_commands get_compile_commands(string_view complete_file_name) const
+    {
+        return CLANGPP_CALL(clang_CompilationDatabase_getCompileCommands)(self.get(), complete_file_name.c_str());
+    }
+    compile_commands get_all_compile_commands() const
+    {
+        return CLANGPP_CALL(clang_CompilationDatabase_getAllCompileCommands)(self.get());
+    }
+};
+
+}
+
+#endif
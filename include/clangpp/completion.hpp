@@ -0,0 +1,104 @@
+#ifndef LIBCLANGPP_COMPLETION_H
+#define LIBCLANGPP_COMPLETION_H
+
+#include <clangpp/diagnostic.hpp>
+#include <clang-c/Index.h>
+
+namespace clang {
+
+struct completion_string
+{
+    CXCompletionString self;
+    completion_string(CXCompletionString s) : self(s)
+    {}
+    CXCompletionChunkKind get_completion_chunk_kind(unsigned chunk_number)
+    {
+        return CLANGPP_CALL(clang_getCompletionChunkKind)(self, chunk_number);
+    }
+    string get_completion_chunk_text(unsigned chunk_number)
+    {
+        return CLANGPP_CALL(clang_getCompletionChunkText)(self, chunk_number);
+    }
+    completion_string get_completion_chunk_completion_string(unsigned chunk_number)
+    {
+        return CLANGPP_CALL(clang_getCompletionChunkCompletionString)(self, chunk_number);
+    }
+    unsigned get_num_completion_chunks()
+    {
+        return CLANGPP_CALL(clang_getNumCompletionChunks)(self);
+    }
+    unsigned get_completion_priority()
+    {
+        return CLANGPP_CALL(clang_getCompletionPriority)(self);
+    }
+    CXAvailabilityKind get_completion_availability()
+    {
+        return CLANGPP_CALL(clang_getCompletionAvailability)(self);
+    }
+    unsigned get_completion_num_annotations()
+    {
+        return CLANGPP_CALL(clang_getCompletionNumAnnotations)(self);
+    }
+    string get_completion_annotation(unsigned annotation_number)
+    {
+        return CLANGPP_CALL(clang_getCompletionAnnotation)(self, annotation_number);
+    }
+    string get_completion_parent(CXCursorKind * kind)
+    {
+        return CLANGPP_CALL(clang_getCompletionParent)(self, kind);
+    }
+    string get_completion_brief_comment()
+    {
+        return CLANGPP_CALL(clang_getCompletionBriefComment)(self);
+    }
+};
+
+struct code_complete_results
+{
+    CLANGPP_UNIQUE_PTR(CXCodeCompleteResults, clang_disposeCodeCompleteResults) self;
+    using iterator = CXCompletionResult*;
+    using const_iterator = CXCompletionResult*;
+
+    code_complete_results(CXCodeCompleteResults* r) : self(r)
+    {}
+
+    auto get_diagnostic()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_codeCompleteGetNumDiagnostics)(self.get()), [this](unsigned i) 
+        {
+            return diagnostic_set::diagnostic(CLANGPP_CALL(clang_codeCompleteGetDiagnostic)(self.get(), i));
+        });
+    }
+
+    string get_container_usr()
+    {
+        return CLANGPP_CALL(clang_codeCompleteGetContainerUSR)(self.get());
+    }
+
+    string get_objc_selector()
+    {
+        return CLANGPP_CALL(clang_codeCompleteGetObjCSelector)(self.get());
+    }
+
+    std::size_t size() const
+    {
+        if (self == nullptr) return 0;
+        else return self->NumResults;
+    }
+
+    iterator begin()
+    {
+        if (self == nullptr) return nullptr;
+        else return self->Results;
+    }
+
+    iterator end()
+    {
+        if (self == nullptr) return nullptr;
+        else return self->Results + self->NumResults;
+    }
+};
+
+}
+
+#endif
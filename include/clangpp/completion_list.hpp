@@ -0,0 +1,125 @@
+#ifndef LIBCLANGPP_COMPLETION_LIST_H
+#define LIBCLANGPP_COMPLETION_LIST_H
+
+#include <clangpp/completion.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace clang {
+
+struct completion_chunk
+{
+    CXCompletionChunkKind kind;
+    // For an optional chunk, the number of chunks right after it that
+    // belong to it
+    std::uint32_t nested;
+    std::uint32_t text;
+};
+
+struct completion_record
+{
+    CXCursorKind cursor_kind;
+    CXAvailabilityKind availability;
+    unsigned priority;
+    // Range in chunks, nested chunks included
+    std::uint32_t first_chunk;
+    std::uint32_t num_chunks;
+    // Range in annotations
+    std::uint32_t first_annotation;
+    std::uint32_t num_annotations;
+    // Text of the typed text chunk, which is what gets filtered and sorted on
+    std::uint32_t typed_text;
+    std::uint32_t parent;
+    std::uint32_t brief_comment;
+};
+
+// Every completion result materialized in one pass into flat arrays. All
+// text, from chunks, annotations, parents and brief comments, is interned
+// as null-terminated strings in one contiguous arena and referred to by id,
+// so repeated text such as punctuation and type names is stored once and
+// nothing needs to be copied again to encode the results.
+struct completion_list
+{
+    std::vector<completion_record> records;
+    std::vector<completion_chunk> chunks;
+    std::vector<std::uint32_t> annotations;
+    detail::string_table strings;
+
+    completion_list()
+    {}
+
+    completion_list(code_complete_results& results)
+    {
+        this->add(results);
+    }
+
+    void add(code_complete_results& results)
+    {
+        records.reserve(records.size() + results.size());
+        chunks.reserve(chunks.size() + results.size() * 8);
+        auto empty = strings.intern("", 0);
+        for(auto&& r:results)
+        {
+            completion_string s{r.CompletionString};
+            completion_record record;
+            record.cursor_kind = r.CursorKind;
+            record.availability = s.get_completion_availability();
+            record.priority = s.get_completion_priority();
+            record.typed_text = empty;
+            record.first_chunk = chunks.size();
+            this->add_chunks(s, record);
+            record.num_chunks = chunks.size() - record.first_chunk;
+            record.first_annotation = annotations.size();
+            record.num_annotations = s.get_completion_num_annotations();
+            for(unsigned i = 0; i < record.num_annotations; i++) annotations.push_back(this->intern(s.get_completion_annotation(i)));
+            record.parent = this->intern(s.get_completion_parent(nullptr));
+            record.brief_comment = this->intern(s.get_completion_brief_comment());
+            records.push_back(record);
+        }
+    }
+
+    std::size_t size() const
+    {
+        return records.size();
+    }
+
+    const char * get_text(std::uint32_t id) const
+    {
+        return strings.get(id);
+    }
+
+    std::size_t get_text_length(std::uint32_t id) const
+    {
+        return strings.get_length(id);
+    }
+
+private:
+    std::uint32_t intern(const string& s)
+    {
+        const char * text = s.c_str();
+        if (text == nullptr) return strings.intern("", 0);
+        return strings.intern(text, std::strlen(text));
+    }
+
+    void add_chunks(completion_string s, completion_record& record)
+    {
+        auto n = s.get_num_completion_chunks();
+        for(unsigned i = 0; i < n; i++)
+        {
+            auto kind = s.get_completion_chunk_kind(i);
+            auto id = chunks.size();
+            chunks.push_back({kind, 0, this->intern(s.get_completion_chunk_text(i))});
+            if (kind == CXCompletionChunk_TypedText) record.typed_text = chunks[id].text;
+            if (kind == CXCompletionChunk_Optional)
+            {
+                this->add_chunks(s.get_completion_chunk_completion_string(i), record);
+                chunks[id].nested = chunks.size() - id - 1;
+            }
+        }
+    }
+};
+
+}
+
+#endif
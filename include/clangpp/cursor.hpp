@@ -0,0 +1,889 @@
+#ifndef LIBCLANGPP_CURSOR_H
+#define LIBCLANGPP_CURSOR_H
+
+#include <clangpp/completion.hpp>
+#include <clangpp/location.hpp>
+#include <functional>
+#include <clang-c/Index.h>
+#include <clang-c/Documentation.h>
+
+namespace clang {
+
+namespace detail {
+
+inline std::vector<CXCursor> get_children(CXCursor c)
+{
+    std::vector<CXCursor> result;
+    CXCursorVisitor visitor = [](CXCursor child, CXCursor, CXClientData data) -> CXChildVisitResult
+    {
+        reinterpret_cast<std::vector<CXCursor>*>(data)->push_back(child);
+        return CXChildVisit_Continue;
+    };
+    CLANGPP_CALL(clang_visitChildren)(c, visitor, &result);
+    return result;
+}
+
+// The children of a cursor, fetched in batches that double in size.
+// libclang only pushes children to a visitor, so each batch visits the
+// children again from the first one and keeps those past the ones already
+// fetched. Fetching every child costs about twice as much as collecting
+// them at once, but stopping after k children only costs O(k).
+struct child_buffer
+{
+    CXCursor parent;
+    std::vector<CXCursor> children;
+    bool complete;
+
+    child_buffer(CXCursor p) : parent(p), complete(false)
+    {}
+
+    // Returns false if the parent has no child i
+    bool fetch(std::size_t i)
+    {
+        while(i >= children.size() && !complete)
+        {
+            struct batch
+            {
+                std::vector<CXCursor> * out;
+                std::size_t skip;
+                std::size_t stop;
+                std::size_t seen;
+            };
+            batch b = {&children, children.size(), std::max<std::size_t>(16, children.size() * 2), 0};
+            CXCursorVisitor visitor = [](CXCursor child, CXCursor, CXClientData data) -> CXChildVisitResult
+            {
+                auto&& self = *reinterpret_cast<batch*>(data);
+                if (self.seen++ >= self.skip) self.out->push_back(child);
+                return self.seen < self.stop ? CXChildVisit_Continue : CXChildVisit_Break;
+            };
+            CLANGPP_CALL(clang_visitChildren)(parent, visitor, &b);
+            complete = b.seen < b.stop;
+        }
+        return i < children.size();
+    }
+};
+
+// What it++ returns for the iterators below, which share their state
+// between copies: it holds the cursor from before the increment
+template<class Cursor>
+struct postfix_cursor
+{
+    Cursor value;
+
+    Cursor operator*() const
+    {
+        return value;
+    }
+};
+
+template<class Cursor>
+struct child_iterator
+{
+    std::shared_ptr<child_buffer> buffer;
+    std::size_t pos;
+
+    using difference_type = std::ptrdiff_t;
+    using value_type = Cursor;
+    using reference = Cursor;
+    using pointer = const Cursor*;
+    using iterator_category = std::input_iterator_tag;
+
+    child_iterator() : pos(0)
+    {}
+
+    child_iterator(CXCursor parent) : buffer(std::make_shared<child_buffer>(parent)), pos(0)
+    {}
+
+    bool done() const
+    {
+        return buffer == nullptr || !buffer->fetch(pos);
+    }
+
+    child_iterator& operator++()
+    {
+        pos++;
+        return *this;
+    }
+
+    postfix_cursor<Cursor> operator++(int)
+    {
+        postfix_cursor<Cursor> result{**this};
+        ++(*this);
+        return result;
+    }
+
+    reference operator*() const
+    {
+        return buffer->children[pos];
+    }
+
+    friend bool operator==(const child_iterator& x, const child_iterator& y)
+    {
+        if (x.done() || y.done()) return x.done() == y.done();
+        return x.buffer == y.buffer && x.pos == y.pos;
+    }
+
+    friend bool operator!=(const child_iterator& x, const child_iterator& y)
+    {
+        return !(x == y);
+    }
+};
+
+// Pre-order traversal driven by an explicit stack. Only the children of
+// cursors that have actually been reached are ever asked from libclang, and
+// only as far as the traversal got, so stopping early leaves the rest of
+// the tree unvisited.
+template<class Cursor>
+struct descendant_iterator
+{
+    struct frame
+    {
+        child_buffer children;
+        std::size_t pos;
+    };
+    std::shared_ptr<std::vector<frame>> stack;
+
+    using difference_type = std::ptrdiff_t;
+    using value_type = Cursor;
+    using reference = Cursor;
+    using pointer = const Cursor*;
+    using iterator_category = std::input_iterator_tag;
+
+    descendant_iterator()
+    {}
+
+    descendant_iterator(CXCursor root) : stack(std::make_shared<std::vector<frame>>())
+    {
+        child_buffer children{root};
+        if (children.fetch(0)) stack->push_back({std::move(children), 0});
+    }
+
+    bool done() const
+    {
+        return stack == nullptr || stack->empty();
+    }
+
+    std::size_t depth() const
+    {
+        return done() ? 0 : stack->size() - 1;
+    }
+
+    // Moves to the next sibling, or the next cursor after the parent, without
+    // visiting the children of the current cursor
+    void skip_children()
+    {
+        while(!stack->empty())
+        {
+            auto&& f = stack->back();
+            f.pos++;
+            if (f.children.fetch(f.pos)) return;
+            stack->pop_back();
+        }
+    }
+
+    descendant_iterator& operator++()
+    {
+        auto&& f = stack->back();
+        child_buffer children{f.children.children[f.pos]};
+        if (children.fetch(0)) stack->push_back({std::move(children), 0});
+        else skip_children();
+        return *this;
+    }
+
+    postfix_cursor<Cursor> operator++(int)
+    {
+        postfix_cursor<Cursor> result{**this};
+        ++(*this);
+        return result;
+    }
+
+    reference operator*() const
+    {
+        return stack->back().children.children[stack->back().pos];
+    }
+
+    friend bool operator==(const descendant_iterator& x, const descendant_iterator& y)
+    {
+        if (x.done() || y.done()) return x.done() == y.done();
+        return x.stack == y.stack;
+    }
+
+    friend bool operator!=(const descendant_iterator& x, const descendant_iterator& y)
+    {
+        return !(x == y);
+    }
+};
+
+}
+
+struct comment
+{
+    CXComment self;
+    comment(CXComment s) : self(s)
+    {}
+    CXCommentKind get_kind()
+    {
+        return CLANGPP_CALL(clang_Comment_getKind)(self);
+    }
+    auto get_children()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_Comment_getNumChildren)(self), [this](unsigned i) 
+        {
+            return comment(CLANGPP_CALL(clang_Comment_getChild)(self, i));
+        });
+    }
+    bool is_whitespace()
+    {
+        return CLANGPP_CALL(clang_Comment_isWhitespace)(self);
+    }
+    unsigned has_trailing_newline()
+    {
+        return CLANGPP_CALL(clang_InlineContentComment_hasTrailingNewline)(self);
+    }
+    string get_text()
+    {
+        return CLANGPP_CALL(clang_TextComment_getText)(self);
+    }
+    string get_inline_command_name()
+    {
+        return CLANGPP_CALL(clang_InlineCommandComment_getCommandName)(self);
+    }
+    CXCommentInlineCommandRenderKind get_render_kind()
+    {
+        return CLANGPP_CALL(clang_InlineCommandComment_getRenderKind)(self);
+    }
+    unsigned get_inline_num_args()
+    {
+        return CLANGPP_CALL(clang_InlineCommandComment_getNumArgs)(self);
+    }
+    string get_inline_arg_text(unsigned arg_idx)
+    {
+        return CLANGPP_CALL(clang_InlineCommandComment_getArgText)(self, arg_idx);
+    }
+    string get_tag_name()
+    {
+        return CLANGPP_CALL(clang_HTMLTagComment_getTagName)(self);
+    }
+    bool is_self_closing()
+    {
+        return CLANGPP_CALL(clang_HTMLStartTagComment_isSelfClosing)(self);
+    }
+    auto get_tag_attributes()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_HTMLStartTag_getNumAttrs)(self), [this](unsigned i) 
+        {
+            return std::make_pair(
+                string(CLANGPP_CALL(clang_HTMLStartTag_getAttrName)(self, i)), 
+                string(CLANGPP_CALL(clang_HTMLStartTag_getAttrValue)(self, i))
+            );
+        });
+    }
+    string get_block_command_name()
+    {
+        return CLANGPP_CALL(clang_BlockCommandComment_getCommandName)(self);
+    }
+    auto get_block_args()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_BlockCommandComment_getNumArgs)(self), [this](unsigned i) 
+        {
+            return string(CLANGPP_CALL(clang_BlockCommandComment_getArgText)(self, i));
+        });
+    }
+    comment get_paragraph()
+    {
+        return CLANGPP_CALL(clang_BlockCommandComment_getParagraph)(self);
+    }
+    string get_param_name()
+    {
+        return CLANGPP_CALL(clang_ParamCommandComment_getParamName)(self);
+    }
+    bool is_param_index_valid()
+    {
+        return CLANGPP_CALL(clang_ParamCommandComment_isParamIndexValid)(self);
+    }
+    unsigned get_param_index()
+    {
+        return CLANGPP_CALL(clang_ParamCommandComment_getParamIndex)(self);
+    }
+    bool is_direction_explicit()
+    {
+        return CLANGPP_CALL(clang_ParamCommandComment_isDirectionExplicit)(self);
+    }
+    CXCommentParamPassDirection get_direction()
+    {
+        return CLANGPP_CALL(clang_ParamCommandComment_getDirection)(self);
+    }
+    string get_template_param_name()
+    {
+        return CLANGPP_CALL(clang_TParamCommandComment_getParamName)(self);
+    }
+    bool is_param_position_valid()
+    {
+        return CLANGPP_CALL(clang_TParamCommandComment_isParamPositionValid)(self);
+    }
+    unsigned get_depth()
+    {
+        return CLANGPP_CALL(clang_TParamCommandComment_getDepth)(self);
+    }
+    unsigned get_index(unsigned depth)
+    {
+        return CLANGPP_CALL(clang_TParamCommandComment_getIndex)(self, depth);
+    }
+    string get_block_text()
+    {
+        return CLANGPP_CALL(clang_VerbatimBlockLineComment_getText)(self);
+    }
+    string get_line_text()
+    {
+        return CLANGPP_CALL(clang_VerbatimLineComment_getText)(self);
+    }
+    string get_as_string()
+    {
+        return CLANGPP_CALL(clang_HTMLTagComment_getAsString)(self);
+    }
+    string get_as_html()
+    {
+        return CLANGPP_CALL(clang_FullComment_getAsHTML)(self);
+    }
+    string get_as_xml()
+    {
+        return CLANGPP_CALL(clang_FullComment_getAsXML)(self);
+    }
+};
+struct cursor;
+struct type
+{
+    CXType self;
+    type(CXType s) : self(s)
+    {}
+    string get_spelling()
+    {
+        return CLANGPP_CALL(clang_getTypeSpelling)(self);
+    }
+    bool equal_types(type b)
+    {
+        return CLANGPP_CALL(clang_equalTypes)(self, b.self);
+    }
+    friend bool operator==(type x, type y)
+    {
+        return x.equal_types(y);
+    }
+    friend bool operator!=(type x, type y)
+    {
+        return !(x == y);
+    }
+    type get_canonical_type()
+    {
+        return CLANGPP_CALL(clang_getCanonicalType)(self);
+    }
+    bool is_const_qualified_type()
+    {
+        return CLANGPP_CALL(clang_isConstQualifiedType)(self);
+    }
+    bool is_volatile_qualified_type()
+    {
+        return CLANGPP_CALL(clang_isVolatileQualifiedType)(self);
+    }
+    bool is_restrict_qualified_type()
+    {
+        return CLANGPP_CALL(clang_isRestrictQualifiedType)(self);
+    }
+    type get_pointee_type()
+    {
+        return CLANGPP_CALL(clang_getPointeeType)(self);
+    }
+    template<class T=void>
+    detail::id<cursor, T> get_declaration()
+    {
+        return CLANGPP_CALL(clang_getTypeDeclaration)(self);
+    }
+    CXCallingConv get_function_calling_conv()
+    {
+        return CLANGPP_CALL(clang_getFunctionTypeCallingConv)(self);
+    }
+    type get_result_type()
+    {
+        return CLANGPP_CALL(clang_getResultType)(self);
+    }
+    auto get_arg_types()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_getNumArgTypes)(self), [this](unsigned i) 
+        {
+            return type(CLANGPP_CALL(clang_getArgType)(self, i));
+        });
+    }
+    bool is_function_variadic()
+    {
+        return CLANGPP_CALL(clang_isFunctionTypeVariadic)(self);
+    }
+    bool is_pod_type()
+    {
+        return CLANGPP_CALL(clang_isPODType)(self);
+    }
+    type get_element_type()
+    {
+        return CLANGPP_CALL(clang_getElementType)(self);
+    }
+    long long get_num_elements()
+    {
+        return CLANGPP_CALL(clang_getNumElements)(self);
+    }
+    type get_array_element_type()
+    {
+        return CLANGPP_CALL(clang_getArrayElementType)(self);
+    }
+    long long get_array_size()
+    {
+        return CLANGPP_CALL(clang_getArraySize)(self);
+    }
+    long long get_align_of()
+    {
+        return CLANGPP_CALL(clang_Type_getAlignOf)(self);
+    }
+    type get_class_type()
+    {
+        return CLANGPP_CALL(clang_Type_getClassType)(self);
+    }
+    long long get_size_of()
+    {
+        return CLANGPP_CALL(clang_Type_getSizeOf)(self);
+    }
+    long long get_offset_of(const char * s)
+    {
+        return CLANGPP_CALL(clang_Type_getOffsetOf)(self, s);
+    }
+    auto get_template_arguments()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_Type_getNumTemplateArguments)(self), [this](unsigned i) 
+        {
+            return type(CLANGPP_CALL(clang_Type_getTemplateArgumentAsType)(self, i));
+        });
+    }
+    CXRefQualifierKind get_cxx_ref_qualifier()
+    {
+        return CLANGPP_CALL(clang_Type_getCXXRefQualifier)(self);
+    }
+    template<class F>
+    unsigned visit_fields(F f)
+    {
+        CXFieldVisitor visitor = [](CXCursor c, CXClientData data) -> CXChildVisitResult
+        {
+            return (*reinterpret_cast<F*>(data))(detail::id<cursor, F>(c));
+        };
+        return CLANGPP_CALL(clang_Type_visitFields)(self, visitor, &f);
+    }
+};
+
+struct module
+{
+    CXModule self;
+    module(CXModule s) : self(s)
+    {}
+    file get_ast_file()
+    {
+        return CLANGPP_CALL(clang_Module_getASTFile)(self);
+    }
+    module get_parent()
+    {
+        return CLANGPP_CALL(clang_Module_getParent)(self);
+    }
+    string get_name()
+    {
+        return CLANGPP_CALL(clang_Module_getName)(self);
+    }
+    string get_full_name()
+    {
+        return CLANGPP_CALL(clang_Module_getFullName)(self);
+    }
+    bool is_system()
+    {
+        return CLANGPP_CALL(clang_Module_isSystem)(self);
+    }
+};
+
+struct module_map_descriptor
+{
+    CLANGPP_UNIQUE_PTR(CXModuleMapDescriptor, clang_ModuleMapDescriptor_dispose) self;
+    module_map_descriptor(unsigned options) : self(CLANGPP_CALL(clang_ModuleMapDescriptor_create)(options))
+    {}
+    CXErrorCode set_framework_module_name(const char * name)
+    {
+        return CLANGPP_CALL(clang_ModuleMapDescriptor_setFrameworkModuleName)(self.get(), name);
+    }
+    CXErrorCode set_umbrella_header(const char * name)
+    {
+        return CLANGPP_CALL(clang_ModuleMapDescriptor_setUmbrellaHeader)(self.get(), name);
+    }
+    CXErrorCode write_to_buffer(unsigned options, char ** out_buffer_ptr, unsigned * out_buffer_size)
+    {
+        return CLANGPP_CALL(clang_ModuleMapDescriptor_writeToBuffer)(self.get(), options, out_buffer_ptr, out_buffer_size);
+    }
+};
+
+struct cursor
+{
+    CXCursor self;
+    cursor() : self(CLANGPP_CALL(clang_getNullCursor)())
+    {}
+    cursor(CXCursor s) : self(s)
+    {}
+    bool equal_cursors(cursor cursor_var)
+    {
+        return CLANGPP_CALL(clang_equalCursors)(self, cursor_var.self);
+    }
+    bool is_null()
+    {
+        return CLANGPP_CALL(clang_Cursor_isNull)(self);
+    }
+    unsigned hash()
+    {
+        return CLANGPP_CALL(clang_hashCursor)(self);
+    }
+    CXCursorKind get_kind()
+    {
+        return CLANGPP_CALL(clang_getCursorKind)(self);
+    }
+    CXLinkageKind get_linkage()
+    {
+        return CLANGPP_CALL(clang_getCursorLinkage)(self);
+    }
+    CXVisibilityKind get_cursor_visibility()
+    {
+        return CLANGPP_CALL(clang_getCursorVisibility)(self);
+    }
+    CXAvailabilityKind get_availability()
+    {
+        return CLANGPP_CALL(clang_getCursorAvailability)(self);
+    }
+    int get_platform_availability(int * always_deprecated, CXString * deprecated_message, int * always_unavailable, CXString * unavailable_message, CXPlatformAvailability * availability, int availability_size)
+    {
+        return CLANGPP_CALL(clang_getCursorPlatformAvailability)(self, always_deprecated, deprecated_message, always_unavailable, unavailable_message, availability, availability_size);
+    }
+    CXLanguageKind get_language()
+    {
+        return CLANGPP_CALL(clang_getCursorLanguage)(self);
+    }
+    module get_module()
+    {
+        return CLANGPP_CALL(clang_Cursor_getModule)(self);
+    }
+    // std::shared_ptr<translation_unit> get_translation_unit()
+    // {
+    //     return clang_Cursor_getTranslationUnit(self);
+    // }
+    cursor get_semantic_parent()
+    {
+        return CLANGPP_CALL(clang_getCursorSemanticParent)(self);
+    }
+    cursor get_lexical_parent()
+    {
+        return CLANGPP_CALL(clang_getCursorLexicalParent)(self);
+    }
+    void get_overridden_cursors(CXCursor ** overridden, unsigned * num_overridden)
+    {
+        CLANGPP_CALL(clang_getOverriddenCursors)(self, overridden, num_overridden);
+    }
+    file get_included_file()
+    {
+        return CLANGPP_CALL(clang_getIncludedFile)(self);
+    }
+    source_location get_location()
+    {
+        return CLANGPP_CALL(clang_getCursorLocation)(self);
+    }
+    source_range get_extent()
+    {
+        return CLANGPP_CALL(clang_getCursorExtent)(self);
+    }
+    type get_type()
+    {
+        return CLANGPP_CALL(clang_getCursorType)(self);
+    }
+    type get_typedef_decl_underlying_type()
+    {
+        return CLANGPP_CALL(clang_getTypedefDeclUnderlyingType)(self);
+    }
+    type get_enum_decl_integer_type()
+    {
+        return CLANGPP_CALL(clang_getEnumDeclIntegerType)(self);
+    }
+    long long get_enum_constant_decl_value()
+    {
+        return CLANGPP_CALL(clang_getEnumConstantDeclValue)(self);
+    }
+    unsigned long long get_enum_constant_decl_unsigned_value()
+    {
+        return CLANGPP_CALL(clang_getEnumConstantDeclUnsignedValue)(self);
+    }
+    int get_field_decl_bit_width()
+    {
+        return CLANGPP_CALL(clang_getFieldDeclBitWidth)(self);
+    }
+    auto get_arguments()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_Cursor_getNumArguments)(self), [this](int i)
+        {
+            return cursor(CLANGPP_CALL(clang_Cursor_getArgument)(self, i));
+        });
+    }
+    // TODO: Make range
+    int get_num_template_arguments()
+    {
+        return CLANGPP_CALL(clang_Cursor_getNumTemplateArguments)(self);
+    }
+    CXTemplateArgumentKind get_template_argument_kind(unsigned i)
+    {
+        return CLANGPP_CALL(clang_Cursor_getTemplateArgumentKind)(self, i);
+    }
+    type get_template_argument_type(unsigned i)
+    {
+        return CLANGPP_CALL(clang_Cursor_getTemplateArgumentType)(self, i);
+    }
+    long long get_template_argument_value(unsigned i)
+    {
+        return CLANGPP_CALL(clang_Cursor_getTemplateArgumentValue)(self, i);
+    }
+    unsigned long long get_template_argument_unsigned_value(unsigned i)
+    {
+        return CLANGPP_CALL(clang_Cursor_getTemplateArgumentUnsignedValue)(self, i);
+    }
+    string get_decl_obj_c_type_encoding()
+    {
+        return CLANGPP_CALL(clang_getDeclObjCTypeEncoding)(self);
+    }
+    type get_result_type()
+    {
+        return CLANGPP_CALL(clang_getCursorResultType)(self);
+    }
+    long long get_offset_of_field()
+    {
+        return CLANGPP_CALL(clang_Cursor_getOffsetOfField)(self);
+    }
+    bool is_anonymous()
+    {
+        return CLANGPP_CALL(clang_Cursor_isAnonymous)(self);
+    }
+    bool is_bit_field()
+    {
+        return CLANGPP_CALL(clang_Cursor_isBitField)(self);
+    }
+    bool is_virtual_base()
+    {
+        return CLANGPP_CALL(clang_isVirtualBase)(self);
+    }
+    CX_CXXAccessSpecifier get_cxx_access_specifier()
+    {
+        return CLANGPP_CALL(clang_getCXXAccessSpecifier)(self);
+    }
+    CX_StorageClass get_storage_class()
+    {
+        return CLANGPP_CALL(clang_Cursor_getStorageClass)(self);
+    }
+    auto get_overloaded_decls()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_getNumOverloadedDecls)(self), [this](int i)
+        {
+            return cursor(CLANGPP_CALL(clang_getOverloadedDecl)(self, i));
+        });
+    }
+    type get_ib_outlet_collection_type()
+    {
+        return CLANGPP_CALL(clang_getIBOutletCollectionType)(self);
+    }
+    template<class F>
+    unsigned visit_children(F f)
+    {
+        CXCursorVisitor visitor = [](CXCursor c, CXCursor parent, CXClientData data) -> CXChildVisitResult
+        {
+            return (*reinterpret_cast<F*>(data))(cursor(c), cursor(parent));
+        };
+        return CLANGPP_CALL(clang_visitChildren)(self, visitor, &f);
+    }
+    auto children()
+    {
+        using iterator = detail::child_iterator<cursor>;
+        return detail::make_iterator_range(iterator(self), iterator());
+    }
+    auto descendants()
+    {
+        using iterator = detail::descendant_iterator<cursor>;
+        return detail::make_iterator_range(iterator(self), iterator());
+    }
+    string get_usr()
+    {
+        return CLANGPP_CALL(clang_getCursorUSR)(self);
+    }
+    string get_spelling()
+    {
+        return CLANGPP_CALL(clang_getCursorSpelling)(self);
+    }
+    source_range get_spelling_name_range(unsigned piece_index, unsigned options)
+    {
+        return CLANGPP_CALL(clang_Cursor_getSpellingNameRange)(self, piece_index, options);
+    }
+    string get_display_name()
+    {
+        return CLANGPP_CALL(clang_getCursorDisplayName)(self);
+    }
+    cursor get_referenced()
+    {
+        return CLANGPP_CALL(clang_getCursorReferenced)(self);
+    }
+    cursor get_definition()
+    {
+        return CLANGPP_CALL(clang_getCursorDefinition)(self);
+    }
+    bool is_definition()
+    {
+        return CLANGPP_CALL(clang_isCursorDefinition)(self);
+    }
+    cursor get_canonical_cursor()
+    {
+        return CLANGPP_CALL(clang_getCanonicalCursor)(self);
+    }
+    int get_obj_c_selector_index()
+    {
+        return CLANGPP_CALL(clang_Cursor_getObjCSelectorIndex)(self);
+    }
+    bool is_dynamic_call()
+    {
+        return CLANGPP_CALL(clang_Cursor_isDynamicCall)(self);
+    }
+    type get_receiver_type()
+    {
+        return CLANGPP_CALL(clang_Cursor_getReceiverType)(self);
+    }
+    unsigned get_obj_c_property_attributes(unsigned reserved)
+    {
+        return CLANGPP_CALL(clang_Cursor_getObjCPropertyAttributes)(self, reserved);
+    }
+    unsigned get_obj_c_decl_qualifiers()
+    {
+        return CLANGPP_CALL(clang_Cursor_getObjCDeclQualifiers)(self);
+    }
+    bool is_obj_c_optional()
+    {
+        return CLANGPP_CALL(clang_Cursor_isObjCOptional)(self);
+    }
+    bool is_variadic()
+    {
+        return CLANGPP_CALL(clang_Cursor_isVariadic)(self);
+    }
+    source_range get_comment_range()
+    {
+        return CLANGPP_CALL(clang_Cursor_getCommentRange)(self);
+    }
+    string get_raw_comment_text()
+    {
+        return CLANGPP_CALL(clang_Cursor_getRawCommentText)(self);
+    }
+    string get_brief_comment_text()
+    {
+        return CLANGPP_CALL(clang_Cursor_getBriefCommentText)(self);
+    }
+    string get_mangling()
+    {
+        return CLANGPP_CALL(clang_Cursor_getMangling)(self);
+    }
+    // string_set get_cxx_manglings()
+    // {
+    //     return *clang_Cursor_getCXXManglings(self);
+    // }
+    comment get_parsed_comment()
+    {
+        return CLANGPP_CALL(clang_Cursor_getParsedComment)(self);
+    }
+    bool is_mutable()
+    {
+        return CLANGPP_CALL(clang_CXXField_isMutable)(self);
+    }
+    bool is_pure_virtual()
+    {
+        return CLANGPP_CALL(clang_CXXMethod_isPureVirtual)(self);
+    }
+    bool is_static()
+    {
+        return CLANGPP_CALL(clang_CXXMethod_isStatic)(self);
+    }
+    bool is_virtual()
+    {
+        return CLANGPP_CALL(clang_CXXMethod_isVirtual)(self);
+    }
+    bool is_const()
+    {
+        return CLANGPP_CALL(clang_CXXMethod_isConst)(self);
+    }
+    CXCursorKind get_template_kind()
+    {
+        return CLANGPP_CALL(clang_getTemplateCursorKind)(self);
+    }
+    cursor get_specialized_template()
+    {
+        return CLANGPP_CALL(clang_getSpecializedCursorTemplate)(self);
+    }
+    source_range get_reference_name_range(unsigned name_flags, unsigned piece_index)
+    {
+        return CLANGPP_CALL(clang_getCursorReferenceNameRange)(self, name_flags, piece_index);
+    }
+    void get_definition_spelling_and_extent(const char ** start_buf, const char ** end_buf, unsigned * start_line, unsigned * start_column, unsigned * end_line, unsigned * end_column)
+    {
+        CLANGPP_CALL(clang_getDefinitionSpellingAndExtent)(self, start_buf, end_buf, start_line, start_column, end_line, end_column);
+    }
+    completion_string get_completion_string()
+    {
+        return CLANGPP_CALL(clang_getCursorCompletionString)(self);
+    }
+    template<class F>
+    static CXCursorAndRangeVisitor make_range_visitor(F& f)
+    {
+        CXCursorAndRangeVisitor visitor = {};
+        visitor.context = &f;
+        visitor.visit = [](void *context, CXCursor c, CXSourceRange r) -> CXVisitorResult
+        {
+            return (*(reinterpret_cast<F*>(context)))(cursor(c), source_range(r));
+        };
+        return visitor;
+    }
+    template<class F>
+    CXResult find_references_in_file(file file, F f)
+    {
+        return CLANGPP_CALL(clang_findReferencesInFile)(self, file.self, make_range_visitor(f));
+    }
+#ifdef __has_feature
+#  if __has_feature(blocks)
+    CXResult find_references_in_file_with_block(file file_var, CXCursorAndRangeVisitorBlock cursor_and_range_visitor_block_var)
+    {
+        return CLANGPP_CALL(clang_findReferencesInFileWithBlock)(self, file_var, cursor_and_range_visitor_block_var);
+    }
+#endif
+#endif
+};
+
+inline string to_string(CXTypeKind k)
+{
+    return CLANGPP_CALL(clang_getTypeKindSpelling)(k);
+}
+
+inline string to_string(CXCursorKind kind)
+{
+    return CLANGPP_CALL(clang_getCursorKindSpelling)(kind);
+}
+
+}
+
+namespace std {
+
+// Consistent with clang_equalTypes, which compares the type and its translation unit
+template<>
+struct hash<clang::type>
+{
+    std::size_t operator()(clang::type t) const
+    {
+        std::hash<void*> h;
+        return h(t.self.data[0]) * 31 + h(t.self.data[1]);
+    }
+};
+
+}
+
+#endif
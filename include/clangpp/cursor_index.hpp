@@ -0,0 +1,157 @@
+#ifndef LIBCLANGPP_CURSOR_INDEX_H
+#define LIBCLANGPP_CURSOR_INDEX_H
+
+#include <clangpp/cursor.hpp>
+#include <clangpp/translation_unit.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+namespace clang {
+
+struct cursor_position
+{
+    CXFile file;
+    unsigned offset;
+};
+
+namespace detail {
+
+struct cursor_extent
+{
+    CXFile file;
+    unsigned begin;
+    unsigned end;
+};
+
+// Returns false when the extent is null or spans more than one file
+inline bool get_cursor_extent(cursor c, cursor_extent& result)
+{
+    auto extent = c.get_extent();
+    auto start = extent.get_range_start().get_file_location();
+    auto stop = extent.get_range_end().get_file_location();
+    if (start.self == nullptr || start.self != stop.self) return false;
+    result = {start.self, start.offset, stop.offset};
+    return true;
+}
+
+inline bool position_less(const cursor_position& x, const cursor_position& y)
+{
+    if (x.file != y.file) return std::less<CXFile>{}(x.file, y.file);
+    return x.offset < y.offset;
+}
+
+}
+
+// Finds the innermost cursor at each position in a single traversal of the
+// translation unit, which only enters the cursors whose extent contains at
+// least one of the positions. Positions outside of any cursor get a null
+// cursor.
+inline std::vector<cursor> get_cursors(translation_unit& tu, const std::vector<cursor_position>& positions)
+{
+    std::vector<cursor> result(positions.size());
+    std::vector<std::size_t> order(positions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y)
+    {
+        return detail::position_less(positions[x], positions[y]);
+    });
+    auto find = [&](cursor_position p)
+    {
+        return std::lower_bound(order.begin(), order.end(), p, [&](std::size_t i, const cursor_position& q)
+        {
+            return detail::position_less(positions[i], q);
+        });
+    };
+    tu.get_translation_unit_cursor().visit_children([&](cursor c, cursor)
+    {
+        detail::cursor_extent e;
+        if (!detail::get_cursor_extent(c, e)) return CXChildVisit_Recurse;
+        auto first = find({e.file, e.begin});
+        auto last = find({e.file, e.end});
+        if (first == last) return CXChildVisit_Continue;
+        // Children are visited after their parent, so the innermost cursor
+        // is the last one written
+        for(auto it = first; it != last; ++it) result[*it] = c;
+        return CXChildVisit_Recurse;
+    });
+    return result;
+}
+
+const std::uint32_t cursor_index_npos = std::uint32_t(-1);
+
+// The extents of every cursor in one file of a translation unit, for
+// repeated point queries. Extents are nested, so the innermost cursor at an
+// offset is found with a binary search over the start offsets, followed by
+// a walk up to the first ancestor that still contains it.
+struct cursor_index
+{
+    struct node
+    {
+        unsigned begin;
+        unsigned end;
+        std::uint32_t parent;
+    };
+
+    CXFile indexed_file;
+    // In visiting order, so a parent comes before its children
+    std::vector<node> nodes;
+    std::vector<CXCursor> cursors;
+    std::vector<std::uint32_t> by_begin;
+
+    cursor_index(translation_unit& tu, file f) : indexed_file(f.self)
+    {
+        std::vector<std::uint32_t> stack;
+        tu.get_translation_unit_cursor().visit_children([&](cursor c, cursor)
+        {
+            detail::cursor_extent e;
+            if (!detail::get_cursor_extent(c, e)) return CXChildVisit_Recurse;
+            if (e.file != indexed_file) return CXChildVisit_Continue;
+            while(!stack.empty() && nodes[stack.back()].end <= e.begin) stack.pop_back();
+            std::uint32_t id = nodes.size();
+            nodes.push_back({e.begin, e.end, stack.empty() ? cursor_index_npos : stack.back()});
+            cursors.push_back(c.self);
+            stack.push_back(id);
+            return CXChildVisit_Recurse;
+        });
+        by_begin.resize(nodes.size());
+        std::iota(by_begin.begin(), by_begin.end(), 0);
+        std::stable_sort(by_begin.begin(), by_begin.end(), [&](std::uint32_t x, std::uint32_t y)
+        {
+            return nodes[x].begin < nodes[y].begin;
+        });
+    }
+
+    std::size_t size() const
+    {
+        return nodes.size();
+    }
+
+    // Returns a null cursor if no cursor contains the offset
+    cursor get_cursor(unsigned offset) const
+    {
+        auto it = std::upper_bound(by_begin.begin(), by_begin.end(), offset, [&](unsigned x, std::uint32_t i)
+        {
+            return x < nodes[i].begin;
+        });
+        if (it == by_begin.begin()) return {};
+        auto id = *(it - 1);
+        while(id != cursor_index_npos && nodes[id].end <= offset) id = nodes[id].parent;
+        if (id == cursor_index_npos) return {};
+        return cursors[id];
+    }
+
+    std::vector<cursor> get_cursors(const std::vector<unsigned>& offsets) const
+    {
+        std::vector<cursor> result;
+        result.reserve(offsets.size());
+        for(auto offset:offsets) result.push_back(this->get_cursor(offset));
+        return result;
+    }
+};
+
+}
+
+#endif
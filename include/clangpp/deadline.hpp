@@ -0,0 +1,205 @@
+#ifndef LIBCLANGPP_DEADLINE_H
+#define LIBCLANGPP_DEADLINE_H
+
+#include <clangpp/index.hpp>
+#include <clangpp/index_pool.hpp>
+#include <clangpp/parallel.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clang {
+
+struct deadline_result
+{
+    // The index tu was parsed with, declared first so it outlives tu
+    std::shared_ptr<index> owner;
+    expected<translation_unit> tu;
+    // The profile that produced tu
+    parse_profile profile;
+    // A richer profile was tried first but failed or did not finish in time
+    bool degraded;
+};
+
+namespace detail {
+
+struct deadline_call
+{
+    struct attempt
+    {
+        parse_profile profile;
+        bool done = false;
+        std::shared_ptr<index> owner;
+        expected<translation_unit> result = CXError_Failure;
+    };
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<attempt> attempts;
+    // Set once parse has picked its result; attempts that finish later are
+    // released by their own thread
+    bool decided = false;
+
+    static const std::size_t npos = std::size_t(-1);
+
+    // The richest attempt that parsed so far
+    std::size_t get_best() const
+    {
+        for(std::size_t k = 0; k < attempts.size(); k++)
+        {
+            if (attempts[k].done && attempts[k].result) return k;
+        }
+        return npos;
+    }
+
+    bool all_done(std::size_t started) const
+    {
+        for(std::size_t k = 0; k < started; k++)
+        {
+            if (!attempts[k].done) return false;
+        }
+        return true;
+    }
+
+    // Nothing richer than the best attempt can still finish
+    bool is_settled(std::size_t started) const
+    {
+        auto best = get_best();
+        return this->all_done(best == npos ? started : best);
+    }
+};
+
+}
+
+// Parses with a time budget. libclang can not cancel a parse, so instead
+// the profiles are tried from the richest to the cheapest, each started on
+// its own thread with its own index when its share of the budget runs out,
+// or as soon as every profile started before it has failed. No cheaper
+// profile is started once one has parsed. The call returns early only when
+// nothing richer can still finish; otherwise it returns the richest result
+// at the end of the budget, or, past the budget, the first one to finish.
+// Parses that lose keep running on detached threads that own their index,
+// and are released as soon as they finish, so the destructor never waits
+// for them.
+struct deadline_parser
+{
+    deadline_parser(index_options o={}) : opts(o)
+    {}
+
+    deadline_parser(const deadline_parser&)=delete;
+    deadline_parser& operator=(const deadline_parser&)=delete;
+
+    deadline_result parse(const parse_job& job, std::chrono::milliseconds budget, std::vector<parse_profile> profiles={parse_profile::full, parse_profile::declarations_only, parse_profile::lexical_only})
+    {
+        this->reap();
+        if (profiles.empty()) return {nullptr, CXError_InvalidArguments, parse_profile::full, false};
+        auto call = std::make_shared<detail::deadline_call>();
+        for(auto p:profiles)
+        {
+            call->attempts.emplace_back();
+            call->attempts.back().profile = p;
+        }
+        auto n = profiles.size();
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + budget;
+        const auto npos = detail::deadline_call::npos;
+        std::unique_lock<std::mutex> lock(call->m);
+        std::size_t started = 0;
+        while(started < n && call->get_best() == npos)
+        {
+            // The workers are always locked before a call
+            lock.unlock();
+            this->start_attempt(call, started++, job);
+            lock.lock();
+            call->cv.wait_until(lock, start + budget * started / n, [&]
+            {
+                return call->get_best() != npos || call->all_done(started);
+            });
+        }
+        if (!call->cv.wait_until(lock, deadline, [&] { return call->is_settled(started); }))
+        {
+            call->cv.wait(lock, [&] { return call->get_best() != npos || call->all_done(started); });
+        }
+        auto best = call->get_best();
+        // Every profile failed, so report the error of the richest one
+        if (best == npos) best = 0;
+        call->decided = true;
+        auto&& a = call->attempts[best];
+        deadline_result result{std::move(a.owner), std::move(a.result), a.profile, best > 0};
+        // The other attempts that finished are released after the lock
+        std::vector<detail::deadline_call::attempt> losers;
+        for(auto&& x:call->attempts)
+        {
+            if (&x != &a && x.done) losers.push_back(std::move(x));
+        }
+        lock.unlock();
+        return result;
+    }
+
+    // Number of parses still running, including the ones that lost
+    std::size_t get_running()
+    {
+        std::lock_guard<std::mutex> lock(workers_mutex);
+        std::size_t result = 0;
+        for(auto&& w:workers) result += !w.is_done();
+        return result;
+    }
+private:
+    struct worker
+    {
+        std::shared_ptr<detail::deadline_call> call;
+        std::size_t attempt;
+
+        bool is_done() const
+        {
+            std::lock_guard<std::mutex> lock(call->m);
+            return call->attempts[attempt].done;
+        }
+    };
+
+    void start_attempt(std::shared_ptr<detail::deadline_call> call, std::size_t k, const parse_job& job)
+    {
+        auto profile = call->attempts[k].profile;
+        auto index_opts = opts;
+        // The thread only uses what it captures, so it can outlive the parser
+        std::thread([call, k, job, profile, index_opts]
+        {
+            std::shared_ptr<index> idx = make_index(index_opts);
+            auto result = try_parse_job_translation_unit(*idx, job, get_parse_options(profile));
+            std::lock_guard<std::mutex> lock(call->m);
+            auto&& a = call->attempts[k];
+            a.done = true;
+            // A parse that lost keeps result and idx, which are released in
+            // that order right after the lock
+            if (!call->decided)
+            {
+                a.owner = std::move(idx);
+                a.result = std::move(result);
+            }
+            call->cv.notify_all();
+        }).detach();
+        std::lock_guard<std::mutex> lock(workers_mutex);
+        workers.push_back({std::move(call), k});
+    }
+
+    // Forgets the parses that have finished
+    void reap()
+    {
+        std::lock_guard<std::mutex> lock(workers_mutex);
+        workers.erase(std::remove_if(workers.begin(), workers.end(), [](const worker& w)
+        {
+            return w.is_done();
+        }), workers.end());
+    }
+
+    index_options opts;
+    std::mutex workers_mutex;
+    std::vector<worker> workers;
+};
+
+}
+
+#endif
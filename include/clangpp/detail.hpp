@@ -0,0 +1,322 @@
+#ifndef LIBCLANGPP_DETAIL_H
+#define LIBCLANGPP_DETAIL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef CLANGPP_TRACE
+#include <clangpp/trace.hpp>
+#define CLANGPP_CALL(f) clang::detail::traced_call<decltype(&f), &f>{#f}
+#else
+#define CLANGPP_CALL(f) f
+#endif
+
+namespace clang {
+
+namespace detail {
+
+template<class T, class=void>
+struct id_impl { using type = T; };
+
+template<class T, class U=void>
+using id = typename id_impl<T, U>::type;
+
+template<class F, F f>
+struct deleter
+{
+    template<class T>
+    void operator()(T* x) const
+    {
+        if (x != nullptr) { f(x); }
+    }
+};
+
+template<class T, class F, F f>
+using unique_ptr = std::unique_ptr<typename std::remove_pointer<T>::type, deleter<F, f>>;
+
+template<class T>
+using shared_ptr = std::shared_ptr<typename std::remove_pointer<T>::type>;
+
+#define CLANGPP_UNIQUE_PTR(T, F) clang::detail::unique_ptr<typename std::remove_pointer<T>::type, decltype(&F), &F>
+
+template<class F, class Iterator=int>
+struct iota_iterator
+{
+    Iterator index;
+    F* f;
+
+    using difference_type = std::ptrdiff_t;
+    using reference = decltype((*f)(std::declval<Iterator>()));
+    using value_type = typename std::remove_reference<reference>::type;
+    using pointer = typename std::add_pointer<value_type>::type;
+    using iterator_category = std::input_iterator_tag;
+
+    iota_iterator(Iterator i, F& fun) : index(i), f(&fun)
+    {}
+
+    iota_iterator& operator+=(int n)
+    {
+        index += n;
+        return *this;
+    }
+
+    iota_iterator& operator-=(int n)
+    {
+        index += n;
+        return *this;
+    }
+
+    iota_iterator& operator++()
+    {
+        index++;
+        return *this;
+    }
+
+    iota_iterator& operator--()
+    {
+        index--;
+        return *this;
+    }
+
+    iota_iterator operator++(int)
+    {
+        iota_iterator it = *this;
+        index++;
+        return it;
+    }
+
+    iota_iterator operator--(int)
+    {
+        iota_iterator it = *this;
+        index--;
+        return it;
+    }
+    // TODO: operator->
+    reference operator*() const
+    {
+        return (*f)(index);
+    }
+};
+
+template<class F, class Iterator>
+inline iota_iterator<F, Iterator>
+operator +(iota_iterator<F, Iterator> x, iota_iterator<F, Iterator> y)
+{
+    return iota_iterator<F, Iterator>(x.index + y.index, x.f);
+}
+
+template<class F, class Iterator>
+inline iota_iterator<F, Iterator>
+operator -(iota_iterator<F, Iterator> x, iota_iterator<F, Iterator> y)
+{
+    return iota_iterator<F, Iterator>(x.index - y.index, x.f);
+}
+
+template<class F, class Iterator>
+inline bool
+operator ==(iota_iterator<F, Iterator> x, iota_iterator<F, Iterator> y)
+{
+    return x.index == y.index;
+}
+
+template<class F, class Iterator>
+inline bool
+operator !=(iota_iterator<F, Iterator> x, iota_iterator<F, Iterator> y)
+{
+    return x.index != y.index;
+}
+
+template<class F, class Iterator=int>
+struct iota_range
+{
+    F f;
+    Iterator start, stop;
+    iota_range(F f, Iterator start, Iterator stop) 
+    : f(f), start(start), stop(stop)
+    {}
+
+    using iterator = iota_iterator<F, Iterator>;
+    using const_iterator = iota_iterator<F, Iterator>;
+
+    long size() const
+    {
+        return stop - start;
+    }
+
+    bool empty() const
+    {
+        return start == stop;
+    }
+
+    iterator begin()
+    {
+        return iterator(start, f);
+    }
+
+    iterator end()
+    {
+        return iterator(stop, f);
+    }
+};
+
+template<class F, class Iterator>
+iota_range<F, Iterator> make_iota_range(Iterator start, Iterator stop, F f)
+{
+    return iota_range<F, Iterator>(f, start, stop);
+}
+
+template<class F>
+iota_range<F> make_index_range(int start, int stop, F f)
+{
+    return iota_range<F>(f, start, stop);
+}
+
+template<class Iterator>
+struct iterator_range
+{
+    Iterator start, stop;
+    iterator_range(Iterator start, Iterator stop) 
+    : start(start), stop(stop)
+    {}
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    long size() const
+    {
+        return stop - start;
+    }
+
+    bool empty() const
+    {
+        return start == stop;
+    }
+
+    iterator begin()
+    {
+        return start;
+    }
+
+    iterator end()
+    {
+        return stop;
+    }
+};
+
+template<class Iterator>
+iterator_range<Iterator> make_iterator_range(Iterator start, Iterator stop)
+{
+    return {start, stop};
+}
+
+const std::uint64_t fnv_offset = 14695981039346656037ull;
+
+inline std::uint64_t fnv1a(const char * data, std::size_t n, std::uint64_t h=fnv_offset)
+{
+    for(std::size_t i = 0; i < n; i++)
+    {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Null-terminated strings stored once in a single arena, found by content
+// through an open-addressing table of ids
+struct string_table
+{
+    struct entry
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+    std::vector<char> arena;
+    std::vector<entry> entries;
+    // id + 1 of each entry, 0 for an empty slot
+    std::vector<std::uint32_t> slots;
+
+    static const std::uint32_t npos = std::uint32_t(-1);
+
+    const char * get(std::uint32_t id) const
+    {
+        return arena.data() + entries[id].offset;
+    }
+
+    std::uint32_t get_length(std::uint32_t id) const
+    {
+        return entries[id].length;
+    }
+
+    std::uint32_t find(const char * s, std::size_t n) const
+    {
+        if (slots.empty()) return npos;
+        auto mask = slots.size() - 1;
+        for(auto i = fnv1a(s, n) & mask; slots[i] != 0; i = (i + 1) & mask)
+        {
+            auto id = slots[i] - 1;
+            if (entries[id].length == n && std::memcmp(get(id), s, n) == 0) return id;
+        }
+        return npos;
+    }
+
+    // Interns the bytes at the end of the arena, from offset on, and returns
+    // their id; a duplicate is removed from the arena again
+    std::uint32_t intern_tail(std::size_t offset)
+    {
+        auto n = arena.size() - offset;
+        auto id = find(arena.data() + offset, n);
+        if (id != npos)
+        {
+            arena.resize(offset);
+            return id;
+        }
+        arena.push_back('\0');
+        id = entries.size();
+        entries.push_back({std::uint32_t(offset), std::uint32_t(n)});
+        if (entries.size() * 2 > slots.size()) rehash(std::max<std::size_t>(64, slots.size() * 2));
+        else insert_slot(id);
+        return id;
+    }
+
+    std::uint32_t intern(const char * s, std::size_t n)
+    {
+        auto id = find(s, n);
+        if (id != npos) return id;
+        auto offset = arena.size();
+        arena.insert(arena.end(), s, s + n);
+        return intern_tail(offset);
+    }
+
+    std::uint32_t intern(const std::string& s)
+    {
+        return intern(s.data(), s.size());
+    }
+
+private:
+    void insert_slot(std::uint32_t id)
+    {
+        auto mask = slots.size() - 1;
+        auto i = fnv1a(get(id), entries[id].length) & mask;
+        while(slots[i] != 0) i = (i + 1) & mask;
+        slots[i] = id + 1;
+    }
+
+    void rehash(std::size_t n)
+    {
+        slots.assign(n, 0);
+        for(std::uint32_t id = 0; id < entries.size(); id++) insert_slot(id);
+    }
+};
+
+}
+
+}
+
+#endif
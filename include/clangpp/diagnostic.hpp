@@ -0,0 +1,108 @@
+#ifndef LIBCLANGPP_DIAGNOSTIC_H
+#define LIBCLANGPP_DIAGNOSTIC_H
+
+#include <clangpp/location.hpp>
+#include <clang-c/Index.h>
+
+namespace clang {
+
+struct fix_it
+{
+    string replacement;
+    source_range range;
+};
+
+struct diagnostic;
+
+struct diagnostic_set
+{
+    CLANGPP_UNIQUE_PTR(CXDiagnosticSet, clang_disposeDiagnosticSet) self;
+    // diagnostic_set(const char * file, CXLoadDiag_Error * error, CXString * error_string) : self(clang_loadDiagnostics(file, error, error_string))
+    // {}
+    
+
+    diagnostic_set(CXDiagnostic s) : self(s)
+    {}
+    struct diagnostic
+    {
+        CLANGPP_UNIQUE_PTR(CXDiagnostic, clang_disposeDiagnostic) self;
+        diagnostic(CXDiagnostic s) : self(s)
+        {}
+        diagnostic_set get_child_diagnostics()
+        {
+            return CLANGPP_CALL(clang_getChildDiagnostics)(self.get());
+        }
+        string format_diagnostic(unsigned options)
+        {
+            return CLANGPP_CALL(clang_formatDiagnostic)(self.get(), options);
+        }
+        CXDiagnosticSeverity get_severity()
+        {
+            return CLANGPP_CALL(clang_getDiagnosticSeverity)(self.get());
+        }
+        source_location get_location()
+        {
+            return CLANGPP_CALL(clang_getDiagnosticLocation)(self.get());
+        }
+        string get_spelling()
+        {
+            return CLANGPP_CALL(clang_getDiagnosticSpelling)(self.get());
+        }
+        string get_option(CXString * disable)
+        {
+            return CLANGPP_CALL(clang_getDiagnosticOption)(self.get(), disable);
+        }
+        unsigned get_category()
+        {
+            return CLANGPP_CALL(clang_getDiagnosticCategory)(self.get());
+        }
+        string get_category_text()
+        {
+            return CLANGPP_CALL(clang_getDiagnosticCategoryText)(self.get());
+        }
+        unsigned get_num_ranges()
+        {
+            return CLANGPP_CALL(clang_getDiagnosticNumRanges)(self.get());
+        }
+        source_range get_range(unsigned range)
+        {
+            return CLANGPP_CALL(clang_getDiagnosticRange)(self.get(), range);
+        }
+        auto get_fix_its()
+        {
+            return detail::make_index_range(0, CLANGPP_CALL(clang_getDiagnosticNumFixIts)(self.get()), [this](unsigned i)
+            {
+                fix_it x;
+                x.replacement = CLANGPP_CALL(clang_getDiagnosticFixIt)(self.get(), i, &x.range.self);
+                return x;
+            });
+        }
+    };
+
+    unsigned size() const
+    {
+        return CLANGPP_CALL(clang_getNumDiagnosticsInSet)(self.get());
+    }
+
+    diagnostic operator()(unsigned index) const
+    {
+        return CLANGPP_CALL(clang_getDiagnosticInSet)(self.get(), index);
+    }
+    
+    using iterator = detail::iota_iterator<const diagnostic_set>;
+    using const_iterator = detail::iota_iterator<const diagnostic_set>;
+
+    iterator begin() const
+    {
+        return iterator(0, *this);
+    }
+
+    iterator end() const
+    {
+        return iterator(size(), *this);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,277 @@
+#ifndef LIBCLANGPP_DOCUMENTATION_H
+#define LIBCLANGPP_DOCUMENTATION_H
+
+#include <clangpp/cursor.hpp>
+#include <clangpp/parallel.hpp>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace clang {
+
+enum class doc_field
+{
+    brief,
+    param,
+    tparam,
+    returns,
+    verbatim
+};
+
+// A documented declaration. All names and text live in one arena as
+// null-terminated strings, so a record allocates a handful of times no matter
+// how many fields it has, and can be reused across declarations.
+struct doc_record
+{
+    struct field
+    {
+        doc_field kind;
+        unsigned name;
+        unsigned text;
+    };
+
+    CXCursorKind kind;
+    std::string arena;
+    std::vector<field> fields;
+
+    const char * usr() const
+    {
+        return arena.c_str();
+    }
+
+    const char * name(const field& f) const
+    {
+        return arena.c_str() + f.name;
+    }
+
+    const char * text(const field& f) const
+    {
+        return arena.c_str() + f.text;
+    }
+
+    void clear()
+    {
+        arena.clear();
+        fields.clear();
+    }
+
+    unsigned add(const char * s)
+    {
+        unsigned offset = arena.size();
+        if (s != nullptr) arena.append(s);
+        arena.push_back('\0');
+        return offset;
+    }
+
+    // Appends to the text of the last field, dropping its terminator
+    void append(const char * s)
+    {
+        arena.pop_back();
+        if (s != nullptr) arena.append(s);
+        arena.push_back('\0');
+    }
+};
+
+namespace detail {
+
+inline bool is_brief_command(const char * name)
+{
+    return std::strcmp(name, "brief") == 0 || std::strcmp(name, "short") == 0;
+}
+
+inline bool is_return_command(const char * name)
+{
+    return std::strcmp(name, "return") == 0 || std::strcmp(name, "returns") == 0 || std::strcmp(name, "result") == 0;
+}
+
+inline void append_paragraph(doc_record& r, comment c)
+{
+    for(auto child:c.get_children())
+    {
+        switch(child.get_kind())
+        {
+            case CXComment_Text:
+                if (!child.is_whitespace()) r.append(child.get_text().c_str());
+                break;
+            case CXComment_InlineCommand:
+                for(unsigned i = 0; i < child.get_inline_num_args(); i++) r.append(child.get_inline_arg_text(i).c_str());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+inline void add_paragraph(doc_record& r, doc_field kind, const char * name, comment paragraph)
+{
+    r.fields.push_back({kind, r.add(name), 0});
+    r.fields.back().text = r.add("");
+    append_paragraph(r, paragraph);
+}
+
+}
+
+// Walks the parsed comment of a cursor once, writing its brief, parameters,
+// template parameters, return and verbatim blocks into the record. Returns
+// false when the cursor has no documentation.
+inline bool extract_doc(cursor c, doc_record& r)
+{
+    r.clear();
+    auto full = c.get_parsed_comment();
+    if (full.get_kind() != CXComment_FullComment) return false;
+    r.kind = c.get_kind();
+    r.add(c.get_usr().c_str());
+    bool has_brief = false;
+    for(auto child:full.get_children())
+    {
+        switch(child.get_kind())
+        {
+            case CXComment_Paragraph:
+                if (!has_brief && !child.is_whitespace())
+                {
+                    detail::add_paragraph(r, doc_field::brief, "", child);
+                    has_brief = true;
+                }
+                break;
+            case CXComment_BlockCommand:
+            {
+                auto name = child.get_block_command_name();
+                if (detail::is_brief_command(name.c_str()))
+                {
+                    detail::add_paragraph(r, doc_field::brief, "", child.get_paragraph());
+                    has_brief = true;
+                }
+                else if (detail::is_return_command(name.c_str()))
+                {
+                    detail::add_paragraph(r, doc_field::returns, "", child.get_paragraph());
+                }
+                break;
+            }
+            case CXComment_ParamCommand:
+                detail::add_paragraph(r, doc_field::param, child.get_param_name().c_str(), child.get_paragraph());
+                break;
+            case CXComment_TParamCommand:
+                detail::add_paragraph(r, doc_field::tparam, child.get_template_param_name().c_str(), child.get_paragraph());
+                break;
+            case CXComment_VerbatimBlockCommand:
+            {
+                r.fields.push_back({doc_field::verbatim, r.add(child.get_block_command_name().c_str()), 0});
+                r.fields.back().text = r.add("");
+                bool first = true;
+                for(auto line:child.get_children())
+                {
+                    if (line.get_kind() != CXComment_VerbatimBlockLine) continue;
+                    if (!first) r.append("\n");
+                    r.append(line.get_block_text().c_str());
+                    first = false;
+                }
+                break;
+            }
+            case CXComment_VerbatimLine:
+                r.fields.push_back({doc_field::verbatim, r.add(""), 0});
+                r.fields.back().text = r.add(child.get_line_text().c_str());
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+// Calls f(record) for every documented declaration under the cursor, skipping
+// system headers and function bodies.
+template<class F>
+void extract_docs(cursor root, F f)
+{
+    doc_record r;
+    root.visit_children([&](cursor c, cursor)
+    {
+        if (!CLANGPP_CALL(clang_isDeclaration)(c.get_kind())) return CXChildVisit_Continue;
+        if (c.get_location().is_in_system_header()) return CXChildVisit_Continue;
+        if (extract_doc(c, r)) f(static_cast<const doc_record&>(r));
+        return CXChildVisit_Recurse;
+    });
+}
+
+// Extracts documentation from every job in parallel. Declarations seen in
+// more than one translation unit, such as those in shared headers, are only
+// reported once. f is called under a lock, so it may write to a shared sink.
+template<class F>
+std::size_t parallel_extract_docs(const std::vector<parse_job>& jobs, F f, parallel_options opts={})
+{
+    std::mutex m;
+    std::unordered_set<std::string> seen;
+    opts.parse_options |= CXTranslationUnit_SkipFunctionBodies;
+    return parallel_parse(jobs, [&](const parse_job&, translation_unit& tu)
+    {
+        extract_docs(tu.get_translation_unit_cursor(), [&](const doc_record& r)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if (*r.usr() != '\0' && !seen.insert(r.usr()).second) return;
+            f(r);
+        });
+    }, opts);
+}
+
+namespace detail {
+
+inline void write_json_string(std::ostream& os, const char * s)
+{
+    os << '"';
+    for(; *s != '\0'; s++)
+    {
+        switch(*s)
+        {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\r': os << "\\r"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*s) < 0x20)
+                {
+                    const char * hex = "0123456789abcdef";
+                    os << "\\u00" << hex[(*s >> 4) & 0xf] << hex[*s & 0xf];
+                }
+                else os << *s;
+        }
+    }
+    os << '"';
+}
+
+}
+
+// Writes each record as one line of JSON
+struct json_doc_writer
+{
+    std::ostream * os;
+    json_doc_writer(std::ostream& s) : os(&s)
+    {}
+
+    void operator()(const doc_record& r) const
+    {
+        static const char * field_names[] = { "brief", "param", "tparam", "returns", "verbatim" };
+        *os << "{\"usr\":";
+        detail::write_json_string(*os, r.usr());
+        *os << ",\"kind\":" << int(r.kind) << ",\"fields\":[";
+        bool first = true;
+        for(auto&& f:r.fields)
+        {
+            if (!first) *os << ',';
+            *os << "{\"field\":\"" << field_names[int(f.kind)] << "\",\"name\":";
+            detail::write_json_string(*os, r.name(f));
+            *os << ",\"text\":";
+            detail::write_json_string(*os, r.text(f));
+            *os << '}';
+            first = false;
+        }
+        *os << "]}\n";
+    }
+};
+
+}
+
+#endif
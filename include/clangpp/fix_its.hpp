@@ -0,0 +1,271 @@
+#ifndef LIBCLANGPP_FIX_ITS_H
+#define LIBCLANGPP_FIX_ITS_H
+
+#include <clangpp/diagnostic.hpp>
+#include <clangpp/translation_unit.hpp>
+#include <clangpp/parallel.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clang {
+
+// Replaces length bytes at offset in a file
+struct text_edit
+{
+    unsigned offset;
+    unsigned length;
+    std::string replacement;
+
+    friend bool operator<(const text_edit& x, const text_edit& y)
+    {
+        return std::tie(x.offset, x.length, x.replacement) < std::tie(y.offset, y.length, y.replacement);
+    }
+    friend bool operator==(const text_edit& x, const text_edit& y)
+    {
+        return std::tie(x.offset, x.length, x.replacement) == std::tie(y.offset, y.length, y.replacement);
+    }
+};
+
+struct edit_conflict
+{
+    std::string file;
+    text_edit kept;
+    text_edit dropped;
+};
+
+struct fix_it_result
+{
+    std::size_t files = 0;
+    std::size_t edits = 0;
+    std::vector<edit_conflict> conflicts;
+    // Files that could not be rewritten, such as files that changed since
+    // they were parsed and are now shorter than an edit, or files whose
+    // owner can not be kept
+    std::vector<std::string> failed;
+};
+
+namespace detail {
+
+inline std::string get_fix_it_path(file_location loc, const std::string& directory)
+{
+    auto name = loc.get_file_name().to_std_string();
+    if (name.empty() || name[0] == '/' || directory.empty()) return name;
+    return directory + "/" + name;
+}
+
+// The same file can be reached through several spellings, such as
+// different include paths or symlinks, so edits are grouped by the real
+// path of the file. A file that does not exist keeps its name.
+inline std::string get_real_path(const std::string& path)
+{
+    std::unique_ptr<char, void(*)(void*)> real(::realpath(path.c_str(), nullptr), &std::free);
+    if (real == nullptr) return path;
+    return real.get();
+}
+
+// Two insertions at the same place conflict too, since their order is unknown
+inline bool edits_overlap(const text_edit& x, const text_edit& y)
+{
+    if (x.offset == y.offset && x.length == 0 && y.length == 0) return true;
+    return y.offset < x.offset + x.length;
+}
+
+inline bool copy_file_bytes(std::FILE * in, std::FILE * out, std::size_t n, std::vector<char>& buffer)
+{
+    while(n > 0)
+    {
+        auto chunk = std::min(n, buffer.size());
+        if (std::fread(buffer.data(), 1, chunk, in) != chunk) return false;
+        if (std::fwrite(buffer.data(), 1, chunk, out) != chunk) return false;
+        n -= chunk;
+    }
+    return true;
+}
+
+inline bool copy_file_rest(std::FILE * in, std::FILE * out, std::vector<char>& buffer)
+{
+    std::size_t n;
+    while((n = std::fread(buffer.data(), 1, buffer.size(), in)) > 0)
+    {
+        if (std::fwrite(buffer.data(), 1, n, out) != n) return false;
+    }
+    return std::ferror(in) == 0;
+}
+
+// Streams the file through a fixed buffer into a temporary file next to it,
+// which then replaces the original, so memory does not depend on file size.
+// A symlink is resolved first, so the link is kept and its target is
+// rewritten, and the temporary file takes the mode and owner of the
+// original.
+inline bool rewrite_file(const std::string& link_path, const std::vector<text_edit>& edits, std::vector<char>& buffer)
+{
+    std::unique_ptr<char, void(*)(void*)> real(::realpath(link_path.c_str(), nullptr), &std::free);
+    if (real == nullptr) return false;
+    std::string path = real.get();
+    auto tmp = path + ".fixit";
+    std::unique_ptr<FILE, int(*)(FILE*)> in(std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (in == nullptr) return false;
+    struct stat st;
+    if (::fstat(fileno(in.get()), &st) != 0) return false;
+    if (std::fseek(in.get(), 0, SEEK_END) != 0) return false;
+    auto size = std::ftell(in.get());
+    std::rewind(in.get());
+    if (!edits.empty() && edits.back().offset + edits.back().length > std::size_t(size)) return false;
+    std::unique_ptr<FILE, int(*)(FILE*)> out(std::fopen(tmp.c_str(), "wb"), &std::fclose);
+    if (out == nullptr) return false;
+    // A file that can not keep its owner is left alone rather than given
+    // away to the current user
+    struct stat out_st;
+    bool ok = ::fstat(fileno(out.get()), &out_st) == 0;
+    if (ok && (st.st_uid != out_st.st_uid || st.st_gid != out_st.st_gid)) ok = ::fchown(fileno(out.get()), st.st_uid, st.st_gid) == 0;
+    ok = ok && ::fchmod(fileno(out.get()), st.st_mode & 07777) == 0;
+    std::size_t pos = 0;
+    for(auto&& e:edits)
+    {
+        ok = ok && copy_file_bytes(in.get(), out.get(), e.offset - pos, buffer) &&
+            std::fwrite(e.replacement.data(), 1, e.replacement.size(), out.get()) == e.replacement.size() &&
+            std::fseek(in.get(), e.length, SEEK_CUR) == 0;
+        if (!ok) break;
+        pos = e.offset + e.length;
+    }
+    ok = ok && copy_file_rest(in.get(), out.get(), buffer) && std::fflush(out.get()) == 0;
+    in.reset();
+    out.reset();
+    if (ok) ok = std::rename(tmp.c_str(), path.c_str()) == 0;
+    if (!ok) std::remove(tmp.c_str());
+    return ok;
+}
+
+}
+
+// Edits gathered from many translation units, keyed by the real path of
+// each file. An edit to a header that is reported by every translation unit
+// including it is only kept once, however each one spelled the header.
+struct fix_it_set
+{
+    std::map<std::string, std::set<text_edit>> files;
+
+    void add(const std::string& file, text_edit e)
+    {
+        files[detail::get_real_path(file)].insert(std::move(e));
+    }
+
+    // Adds the fix-its of the diagnostic, resolving relative file names
+    // against directory
+    void add(diagnostic_set::diagnostic& d, const std::string& directory="")
+    {
+        for(auto f:d.get_fix_its())
+        {
+            auto start = f.range.get_range_start().get_spelling_location();
+            auto end = f.range.get_range_end().get_spelling_location();
+            if (start.self == nullptr || end.offset < start.offset) continue;
+            add(detail::get_fix_it_path(start, directory), {start.offset, end.offset - start.offset, f.replacement.to_std_string()});
+        }
+    }
+
+    void merge(fix_it_set&& other)
+    {
+        for(auto&& p:other.files)
+        {
+            auto&& edits = files[detail::get_real_path(p.first)];
+            if (edits.empty()) edits = std::move(p.second);
+            else edits.insert(p.second.begin(), p.second.end());
+        }
+        other.files.clear();
+    }
+
+    std::size_t size() const
+    {
+        std::size_t result = 0;
+        for(auto&& p:files) result += p.second.size();
+        return result;
+    }
+
+    // Returns the edits of a file in order, dropping any edit that overlaps
+    // an earlier one
+    std::vector<text_edit> get_edits(const std::string& file, std::vector<edit_conflict>* conflicts=nullptr) const
+    {
+        std::vector<text_edit> result;
+        auto it = files.find(detail::get_real_path(file));
+        if (it == files.end()) return result;
+        for(auto&& e:it->second)
+        {
+            if (!result.empty() && detail::edits_overlap(result.back(), e))
+            {
+                if (conflicts != nullptr) conflicts->push_back({it->first, result.back(), e});
+                continue;
+            }
+            result.push_back(e);
+        }
+        return result;
+    }
+
+    // Rewrites every file in parallel, each in a single pass
+    fix_it_result apply(unsigned threads=std::thread::hardware_concurrency(), std::size_t buffer_size=1 << 16) const
+    {
+        std::vector<const std::string*> names;
+        for(auto&& p:files) names.push_back(&p.first);
+        fix_it_result result;
+        std::mutex m;
+        detail::parallel_for(names.size(), threads, [&](unsigned, std::size_t i)
+        {
+            thread_local std::vector<char> buffer;
+            buffer.resize(buffer_size == 0 ? 1 : buffer_size);
+            std::vector<edit_conflict> conflicts;
+            auto edits = get_edits(*names[i], &conflicts);
+            bool ok = detail::rewrite_file(*names[i], edits, buffer);
+            std::lock_guard<std::mutex> lock(m);
+            result.conflicts.insert(result.conflicts.end(), conflicts.begin(), conflicts.end());
+            if (ok)
+            {
+                result.files++;
+                result.edits += edits.size();
+            }
+            else result.failed.push_back(*names[i]);
+        });
+        return result;
+    }
+};
+
+// Parses every job in parallel and collects the fix-its of each diagnostic
+// for which select(diagnostic) returns true. Fix-its in system headers are
+// skipped.
+template<class F>
+fix_it_set collect_fix_its(const std::vector<parse_job>& jobs, F select, parallel_options opts={})
+{
+    fix_it_set result;
+    std::mutex m;
+    parallel_parse(jobs, [&](const parse_job& job, translation_unit& tu)
+    {
+        fix_it_set local;
+        for(auto d:tu.get_diagnostic())
+        {
+            if (d.get_location().is_in_system_header() || !select(d)) continue;
+            local.add(d, job.directory);
+        }
+        std::lock_guard<std::mutex> lock(m);
+        result.merge(std::move(local));
+    }, opts);
+    return result;
+}
+
+inline fix_it_set collect_fix_its(const std::vector<parse_job>& jobs, parallel_options opts={})
+{
+    return collect_fix_its(jobs, [](diagnostic_set::diagnostic&) { return true; }, opts);
+}
+
+}
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef LIBCLANGPP_HEADER_REGISTRY_H
+#define LIBCLANGPP_HEADER_REGISTRY_H
+
+#include <clangpp/index.hpp>
+#include <clangpp/index_pool.hpp>
+#include <clangpp/parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace clang {
+
+// A header as seen by a translation unit: the file, and a hash of the
+// command line options that can change what it declares
+struct header_key
+{
+    CXFileUniqueID id;
+    std::uint64_t context;
+
+    friend bool operator==(const header_key& x, const header_key& y)
+    {
+        return x.context == y.context && std::memcmp(x.id.data, y.id.data, sizeof(x.id.data)) == 0;
+    }
+    friend bool operator!=(const header_key& x, const header_key& y)
+    {
+        return !(x == y);
+    }
+};
+
+namespace detail {
+
+struct header_key_hash
+{
+    std::size_t operator()(const header_key& k) const
+    {
+        return fnv1a(reinterpret_cast<const char *>(k.id.data), sizeof(k.id.data), k.context);
+    }
+};
+
+inline bool is_macro_context_option(const std::string& arg, bool& takes_value)
+{
+    takes_value = arg == "-D" || arg == "-U" || arg == "-include" || arg == "-imacros" || arg == "-x" || arg == "-target";
+    if (takes_value) return true;
+    for(auto prefix:{"-D", "-U", "-std=", "-x", "-f", "--target=", "-include", "-imacros"})
+    {
+        if (arg.compare(0, std::strlen(prefix), prefix) == 0) return true;
+    }
+    return false;
+}
+
+}
+
+// Hashes the macro definitions, forced includes, language and target of a
+// job. Two translation units with the same macro context see the same
+// declarations in a header, in the common case where headers do not depend
+// on macros defined by the including file.
+inline std::uint64_t get_macro_context(const parse_job& job)
+{
+    auto h = detail::fnv_offset;
+    for(std::size_t i = 0; i < job.args.size(); i++)
+    {
+        bool takes_value;
+        if (!detail::is_macro_context_option(job.args[i], takes_value)) continue;
+        h = detail::fnv1a(job.args[i].c_str(), job.args[i].size() + 1, h);
+        if (takes_value && i + 1 < job.args.size())
+        {
+            i++;
+            h = detail::fnv1a(job.args[i].c_str(), job.args[i].size() + 1, h);
+        }
+    }
+    return h;
+}
+
+// The headers already indexed by some translation unit, shared by every
+// worker of a bulk indexing run. The first translation unit to claim a
+// header reports its declarations and references; the others skip them.
+struct header_registry
+{
+    header_registry()
+    {}
+    header_registry(const header_registry&)=delete;
+    header_registry& operator=(const header_registry&)=delete;
+
+    // Returns true if no one claimed the header before
+    bool claim(const header_key& k)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return headers.insert(k).second;
+    }
+
+    // Gives up the claims of a translation unit that failed to index, so a
+    // translation unit that includes those headers later reports them
+    // instead. Declarations that other translation units already skipped
+    // are not reported again, so when released is not zero the results may
+    // be missing declarations from those headers, and the jobs that include
+    // them have to be indexed again with a new registry.
+    void release(const std::vector<header_key>& keys)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        for(auto&& k:keys) released += headers.erase(k);
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return headers.size();
+    }
+
+    // Declarations and references that were not reported because their
+    // header was claimed by another translation unit
+    std::atomic<std::size_t> skipped{0};
+    // Headers whose claims were given up after the translation unit that
+    // owned them failed to index
+    std::atomic<std::size_t> released{0};
+private:
+    std::mutex m;
+    std::unordered_set<header_key, detail::header_key_hash> headers;
+};
+
+namespace detail {
+
+inline CXIdxClientFile get_owned_file_tag()
+{
+    static char tag;
+    return &tag;
+}
+
+inline CXIdxClientFile get_skipped_file_tag()
+{
+    static char tag;
+    return &tag;
+}
+
+template<class Decl, class Ref>
+struct dedup_index_state
+{
+    header_registry * registry;
+    std::uint64_t context;
+    const parse_job * job;
+    Decl * on_declaration;
+    Ref * on_reference;
+    std::unordered_map<CXFile, bool> files;
+    std::vector<header_key> claimed;
+
+    bool owns(CXFile f)
+    {
+        if (f == nullptr) return true;
+        auto it = files.find(f);
+        if (it != files.end()) return it->second;
+        bool owned = true;
+        CXFileUniqueID id;
+        if (CLANGPP_CALL(clang_getFileUniqueID)(f, &id) == 0)
+        {
+            header_key k{id, context};
+            owned = registry->claim(k);
+            if (owned) claimed.push_back(k);
+        }
+        files.emplace(f, owned);
+        return owned;
+    }
+
+    CXIdxClientFile get_client_file(CXFile f)
+    {
+        return this->owns(f) ? get_owned_file_tag() : get_skipped_file_tag();
+    }
+
+    // Files announced through ppIncludedFile come back as client files, so
+    // most locations are resolved without a lookup
+    bool owns(CXIdxLoc loc)
+    {
+        CXIdxClientFile client_file = nullptr;
+        CXFile f = nullptr;
+        idx_loc{loc}.get_file_location(&client_file, &f, nullptr, nullptr, nullptr);
+        if (client_file == get_owned_file_tag()) return true;
+        if (client_file == get_skipped_file_tag()) return false;
+        return this->owns(f);
+    }
+
+    static IndexerCallbacks get_callbacks()
+    {
+        IndexerCallbacks callbacks = {};
+        callbacks.enteredMainFile = [](CXClientData data, CXFile f, void *) -> CXIdxClientFile
+        {
+            auto self = reinterpret_cast<dedup_index_state*>(data);
+            self->files[f] = true;
+            return get_owned_file_tag();
+        };
+        callbacks.ppIncludedFile = [](CXClientData data, const CXIdxIncludedFileInfo * info) -> CXIdxClientFile
+        {
+            return reinterpret_cast<dedup_index_state*>(data)->get_client_file(info->file);
+        };
+        callbacks.indexDeclaration = [](CXClientData data, const CXIdxDeclInfo * info)
+        {
+            auto self = reinterpret_cast<dedup_index_state*>(data);
+            if (self->owns(info->loc)) (*self->on_declaration)(*self->job, info);
+            else self->registry->skipped++;
+        };
+        callbacks.indexEntityReference = [](CXClientData data, const CXIdxEntityRefInfo * info)
+        {
+            auto self = reinterpret_cast<dedup_index_state*>(data);
+            if (self->owns(info->loc)) (*self->on_reference)(*self->job, info);
+            else self->registry->skipped++;
+        };
+        return callbacks;
+    }
+};
+
+}
+
+// Parses and indexes every job in parallel, calling
+// on_declaration(job, const CXIdxDeclInfo*) and
+// on_reference(job, const CXIdxEntityRefInfo*) from the worker threads.
+// Each worker keeps one index action per macro context and indexes with
+// CXIndexOpt_SkipParsedBodiesInSession, so the bodies of functions in a
+// header are only parsed and indexed by the first translation unit on that
+// worker that includes it. Every translation unit still parses the
+// declarations of the headers it includes; the registry makes sure those
+// are only reported by the first translation unit that includes the header
+// with a given macro context. Returns the number of jobs that failed to
+// parse or index.
+template<class Decl, class Ref>
+std::size_t parallel_index(const std::vector<parse_job>& jobs, Decl on_declaration, Ref on_reference, header_registry& registry, parallel_options opts={})
+{
+    using state = detail::dedup_index_state<Decl, Ref>;
+    index_pool pool{opts.index_opts};
+    // Skipped bodies are tracked per action, so an action is never shared
+    // by translation units that may see a header differently
+    std::vector<std::unordered_map<std::uint64_t, index::action>> actions(std::max(opts.threads, 1u));
+    std::atomic<std::size_t> failures{0};
+    auto schedule = detail::get_parse_schedule(jobs, opts);
+    detail::parallel_for(jobs.size(), opts.threads, [&](unsigned thread_id, std::size_t k)
+    {
+        auto i = schedule[k];
+        auto&& job = jobs[i];
+        if (opts.cancel != nullptr && *opts.cancel) return;
+        auto context = get_macro_context(job);
+        auto it = actions[thread_id].find(context);
+        if (it == actions[thread_id].end()) it = actions[thread_id].emplace(context, pool.get().create()).first;
+        state s{&registry, context, &job, &on_declaration, &on_reference, {}, {}};
+        auto callbacks = state::get_callbacks();
+        std::string working_dir;
+        auto argv = detail::make_argv(job, working_dir);
+        auto start = std::chrono::steady_clock::now();
+        // The compiler is left out, as clang_indexSourceFile does not expect it
+        int error = it->second.index_source_file(&s, &callbacks, sizeof(callbacks), CXIndexOpt_SkipParsedBodiesInSession,
+            nullptr, argv.data() + !argv.empty(), argv.size() - !argv.empty(), nullptr, 0, nullptr, opts.parse_options);
+        if (error != 0)
+        {
+            registry.release(s.claimed);
+            failures++;
+        }
+        else if (opts.history != nullptr)
+        {
+            opts.history->record(job, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+    });
+    return failures;
+}
+
+template<class Decl, class Ref>
+std::size_t parallel_index(const std::vector<parse_job>& jobs, Decl on_declaration, Ref on_reference, parallel_options opts={})
+{
+    header_registry registry;
+    return parallel_index(jobs, on_declaration, on_reference, registry, opts);
+}
+
+}
+
+#endif
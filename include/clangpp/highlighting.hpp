@@ -0,0 +1,269 @@
+#ifndef LIBCLANGPP_HIGHLIGHTING_H
+#define LIBCLANGPP_HIGHLIGHTING_H
+
+#include <clangpp/translation_unit.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace clang {
+
+enum class highlight_kind : std::uint8_t
+{
+    keyword,
+    comment,
+    literal,
+    preprocessor,
+    macro,
+    namespace_,
+    type,
+    enumerator,
+    field,
+    function,
+    method,
+    variable,
+    parameter,
+    template_parameter,
+    label
+};
+
+enum highlight_modifier : std::uint8_t
+{
+    highlight_declaration = 1 << 0,
+    highlight_definition = 1 << 1,
+    highlight_static = 1 << 2,
+    highlight_virtual = 1 << 3,
+    highlight_readonly = 1 << 4,
+    highlight_deprecated = 1 << 5
+};
+
+struct highlight_span
+{
+    std::uint32_t offset;
+    std::uint32_t length;
+    highlight_kind kind;
+    std::uint8_t modifiers;
+};
+
+// Passed as the last line to highlight up to the end of the file
+const unsigned highlight_end_of_file = 1u << 30;
+
+namespace detail {
+
+inline bool get_highlight_kind(CXCursorKind kind, highlight_kind& result)
+{
+    switch(kind)
+    {
+        case CXCursor_InclusionDirective:
+        case CXCursor_PreprocessingDirective:
+            result = highlight_kind::preprocessor;
+            return true;
+        case CXCursor_MacroDefinition:
+        case CXCursor_MacroExpansion:
+            result = highlight_kind::macro;
+            return true;
+        case CXCursor_Namespace:
+        case CXCursor_NamespaceAlias:
+        case CXCursor_NamespaceRef:
+            result = highlight_kind::namespace_;
+            return true;
+        case CXCursor_StructDecl:
+        case CXCursor_UnionDecl:
+        case CXCursor_ClassDecl:
+        case CXCursor_EnumDecl:
+        case CXCursor_TypedefDecl:
+        case CXCursor_TypeAliasDecl:
+        case CXCursor_TypeAliasTemplateDecl:
+        case CXCursor_ClassTemplate:
+        case CXCursor_ClassTemplatePartialSpecialization:
+        case CXCursor_TypeRef:
+            result = highlight_kind::type;
+            return true;
+        case CXCursor_EnumConstantDecl:
+            result = highlight_kind::enumerator;
+            return true;
+        case CXCursor_FieldDecl:
+            result = highlight_kind::field;
+            return true;
+        case CXCursor_FunctionDecl:
+        case CXCursor_FunctionTemplate:
+            result = highlight_kind::function;
+            return true;
+        case CXCursor_CXXMethod:
+        case CXCursor_Constructor:
+        case CXCursor_Destructor:
+        case CXCursor_ConversionFunction:
+            result = highlight_kind::method;
+            return true;
+        case CXCursor_VarDecl:
+            result = highlight_kind::variable;
+            return true;
+        case CXCursor_ParmDecl:
+            result = highlight_kind::parameter;
+            return true;
+        case CXCursor_TemplateTypeParameter:
+        case CXCursor_NonTypeTemplateParameter:
+        case CXCursor_TemplateTemplateParameter:
+            result = highlight_kind::template_parameter;
+            return true;
+        case CXCursor_LabelStmt:
+        case CXCursor_LabelRef:
+            result = highlight_kind::label;
+            return true;
+        default:
+            return false;
+    }
+}
+
+inline std::uint8_t get_highlight_modifiers(cursor annotated, cursor decl, unsigned offset)
+{
+    std::uint8_t result = 0;
+    if (annotated.equal_cursors(decl) && annotated.get_location().get_spelling_location().offset == offset)
+    {
+        result |= highlight_declaration;
+        if (decl.is_definition()) result |= highlight_definition;
+    }
+    auto kind = decl.get_kind();
+    if (kind == CXCursor_CXXMethod)
+    {
+        if (decl.is_static()) result |= highlight_static;
+        if (decl.is_virtual()) result |= highlight_virtual;
+    }
+    else if (kind == CXCursor_VarDecl || kind == CXCursor_FunctionDecl)
+    {
+        if (decl.get_storage_class() == CX_SC_Static) result |= highlight_static;
+    }
+    if (kind == CXCursor_VarDecl || kind == CXCursor_FieldDecl || kind == CXCursor_ParmDecl)
+    {
+        // A const reference is as readonly as a const variable
+        auto t = decl.get_type();
+        if (t.self.kind == CXType_LValueReference || t.self.kind == CXType_RValueReference) t = t.get_pointee_type();
+        if (t.is_const_qualified_type()) result |= highlight_readonly;
+    }
+    if (decl.get_availability() == CXAvailability_Deprecated) result |= highlight_deprecated;
+    return result;
+}
+
+}
+
+// Computes semantic highlighting for one file of a translation unit. Tokens
+// are annotated in one call to clang_annotateTokens into a buffer that is
+// reused between calls. When the tokens of the requested lines are the same
+// as the last time, such as after a reparse for an edit elsewhere in the
+// file, the previous spans are returned without annotating again; call
+// invalidate when a change in an included header could change their meaning.
+struct highlighter
+{
+    highlighter()
+    {}
+
+    highlighter(const highlighter&)=delete;
+    highlighter& operator=(const highlighter&)=delete;
+
+    const std::vector<highlight_span>& highlight(translation_unit& tu, string_view filename, unsigned first_line=1, unsigned last_line=highlight_end_of_file)
+    {
+        auto f = tu.get_file(filename);
+        if (f.self == nullptr)
+        {
+            invalidate();
+            spans.clear();
+            return spans;
+        }
+        auto start = tu.get_location(f, first_line, 1);
+        // A line past the end of the file is clamped to the end of the file
+        auto end = tu.get_location(f, last_line + 1, 1);
+        CXToken * start_token;
+        unsigned size;
+        CLANGPP_CALL(clang_tokenize)(tu.self.get(), source_range(start, end).self, &start_token, &size);
+        translation_unit::token_array_handler tokens(start_token, size, tu.self);
+
+        auto key = hash_tokens(tu, tokens, filename, first_line, last_line);
+        if (valid && key == last_key) return spans;
+
+        cursors.resize(size);
+        tu.annotate_tokens(tokens.tokens, size, cursors.data());
+        spans.clear();
+        for(unsigned i = 0; i < size; i++) add_span(tu, tokens.tokens[i], cursors[i]);
+        last_key = key;
+        valid = true;
+        return spans;
+    }
+
+    const std::vector<highlight_span>& get_spans() const
+    {
+        return spans;
+    }
+
+    void invalidate()
+    {
+        valid = false;
+    }
+
+private:
+    std::vector<highlight_span> spans;
+    std::vector<CXCursor> cursors;
+    std::uint64_t last_key = 0;
+    bool valid = false;
+
+    static std::uint64_t hash_tokens(translation_unit& tu, const translation_unit::token_array_handler& tokens, string_view filename, unsigned first_line, unsigned last_line)
+    {
+        unsigned header[] = { first_line, last_line, tokens.size };
+        auto h = detail::fnv1a(filename.c_str(), std::strlen(filename.c_str()) + 1);
+        h = detail::fnv1a(reinterpret_cast<const char*>(header), sizeof(header), h);
+        for(unsigned i = 0; i < tokens.size; i++)
+        {
+            token t{tokens.tokens[i], tu.self};
+            unsigned data[] = { unsigned(t.get_kind()), t.get_location().get_spelling_location().offset };
+            h = detail::fnv1a(reinterpret_cast<const char*>(data), sizeof(data), h);
+            auto spelling = t.get_spelling();
+            h = detail::fnv1a(spelling.c_str(), std::strlen(spelling.c_str()) + 1, h);
+        }
+        return h;
+    }
+
+    void add_span(translation_unit& tu, CXToken t, cursor annotated)
+    {
+        token tok{t, tu.self};
+        auto extent = tok.get_extent();
+        auto offset = extent.get_range_start().get_spelling_location().offset;
+        std::uint32_t length = extent.get_range_end().get_spelling_location().offset - offset;
+        auto annotated_kind = annotated.get_kind();
+        highlight_kind kind;
+        switch(tok.get_kind())
+        {
+            case CXToken_Punctuation:
+                return;
+            case CXToken_Comment:
+                spans.push_back({offset, length, highlight_kind::comment, 0});
+                return;
+            case CXToken_Keyword:
+            case CXToken_Literal:
+                if (annotated_kind == CXCursor_InclusionDirective || annotated_kind == CXCursor_PreprocessingDirective)
+                    kind = highlight_kind::preprocessor;
+                else
+                    kind = tok.get_kind() == CXToken_Keyword ? highlight_kind::keyword : highlight_kind::literal;
+                spans.push_back({offset, length, kind, 0});
+                return;
+            case CXToken_Identifier:
+                break;
+        }
+        if (detail::get_highlight_kind(annotated_kind, kind) &&
+            (kind == highlight_kind::preprocessor || kind == highlight_kind::macro))
+        {
+            spans.push_back({offset, length, kind, 0});
+            return;
+        }
+        auto decl = annotated;
+        if (!CLANGPP_CALL(clang_isDeclaration)(annotated_kind))
+        {
+            decl = annotated.get_referenced();
+            if (decl.is_null()) return;
+        }
+        if (!detail::get_highlight_kind(decl.get_kind(), kind)) return;
+        spans.push_back({offset, length, kind, detail::get_highlight_modifiers(annotated, decl, offset)});
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef LIBCLANGPP_INCREMENTAL_H
+#define LIBCLANGPP_INCREMENTAL_H
+
+#include <clangpp/translation_unit.hpp>
+#include <clangpp/parallel.hpp>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/stat.h>
+
+namespace clang {
+
+namespace detail {
+
+inline std::uint64_t hash_file_contents(const std::string& path)
+{
+    std::ifstream is(path, std::ios::binary);
+    if (!is) return 0;
+    std::uint64_t h = fnv_offset;
+    char buffer[1 << 16];
+    while(is)
+    {
+        is.read(buffer, sizeof(buffer));
+        h = fnv1a(buffer, is.gcount(), h);
+    }
+    return h;
+}
+
+// Content hashes shared by the workers of a refresh, so a header included
+// by many translation units is only read once. A hash is reused only for
+// the same modification time.
+struct file_hash_cache
+{
+    std::uint64_t get(const std::string& path, time_t time)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            auto it = hashes.find(path);
+            if (it != hashes.end() && it->second.first == time) return it->second.second;
+        }
+        auto h = hash_file_contents(path);
+        std::lock_guard<std::mutex> lock(m);
+        hashes[path] = {time, h};
+        return h;
+    }
+private:
+    std::mutex m;
+    std::unordered_map<std::string, std::pair<time_t, std::uint64_t>> hashes;
+};
+
+}
+
+struct file_dependency
+{
+    std::string name;
+    CXFileUniqueID id;
+    time_t time;
+    std::uint64_t hash;
+};
+
+struct tu_dependencies
+{
+    std::uint64_t command_hash;
+    std::vector<file_dependency> files;
+};
+
+// Records the files each translation unit depended on the last time it was
+// indexed, so that a refresh only reparses the translation units whose
+// command line or dependencies have changed since.
+struct incremental_index
+{
+    std::unordered_map<std::string, tu_dependencies> records;
+
+    static tu_dependencies get_dependencies(translation_unit& tu, const parse_job& job)
+    {
+        detail::file_hash_cache cache;
+        return get_dependencies(tu, job, cache);
+    }
+
+    static tu_dependencies get_dependencies(translation_unit& tu, const parse_job& job, detail::file_hash_cache& cache)
+    {
+        tu_dependencies result;
+        result.command_hash = detail::hash_command(job);
+        std::vector<CXFile> files;
+        CXInclusionVisitor visitor = [](CXFile f, CXSourceLocation *, unsigned, CXClientData data)
+        {
+            reinterpret_cast<std::vector<CXFile>*>(data)->push_back(f);
+        };
+        tu.get_inclusions(visitor, &files);
+        std::set<std::array<unsigned long long, 3>> seen;
+        for(auto f:files)
+        {
+            file_dependency d;
+            d.name = file(f).get_file_name().to_std_string();
+            try
+            {
+                d.id = file(f).get_file_unique_id();
+            }
+            catch(const std::runtime_error&)
+            {
+                continue;
+            }
+            std::array<unsigned long long, 3> key{{d.id.data[0], d.id.data[1], d.id.data[2]}};
+            if (!seen.insert(key).second) continue;
+            d.time = file(f).get_file_time();
+            d.hash = cache.get(d.name, d.time);
+            result.files.push_back(std::move(d));
+        }
+        return result;
+    }
+
+    // Returns the jobs that need to be reparsed, and forgets translation units
+    // that are no longer part of the jobs
+    std::vector<parse_job> get_stale_jobs(const std::vector<parse_job>& jobs)
+    {
+        // Headers are shared by many translation units, so each file is only
+        // read once per refresh. The answer still depends on what each
+        // translation unit recorded, so only the state of the file is cached.
+        struct file_state
+        {
+            bool exists;
+            time_t time;
+            bool hashed;
+            std::uint64_t hash;
+        };
+        std::unordered_map<std::string, file_state> states;
+        auto is_changed = [&](file_dependency& d)
+        {
+            auto it = states.find(d.name);
+            if (it == states.end())
+            {
+                file_state state{false, 0, false, 0};
+                struct stat st;
+                if (::stat(d.name.c_str(), &st) == 0) state = {true, st.st_mtime, false, 0};
+                it = states.emplace(d.name, state).first;
+            }
+            auto&& state = it->second;
+            if (!state.exists) return true;
+            if (state.time == d.time) return false;
+            if (!state.hashed)
+            {
+                state.hash = detail::hash_file_contents(d.name);
+                state.hashed = true;
+            }
+            // A file that was touched but not modified is unchanged
+            if (state.hash != d.hash) return true;
+            d.time = state.time;
+            return false;
+        };
+        std::vector<parse_job> result;
+        std::unordered_map<std::string, tu_dependencies> current;
+        for(auto&& job:jobs)
+        {
+            auto it = records.find(job.filename);
+            bool stale = it == records.end() || it->second.command_hash != detail::hash_command(job);
+            if (!stale)
+            {
+                for(auto&& d:it->second.files)
+                {
+                    if (is_changed(d))
+                    {
+                        stale = true;
+                        break;
+                    }
+                }
+            }
+            if (stale) result.push_back(job);
+            else current.emplace(job.filename, std::move(it->second));
+        }
+        records = std::move(current);
+        return result;
+    }
+
+    // Reparses the stale jobs, calling f(job, tu) for each one, and records
+    // their new dependencies. Returns the number of jobs that failed to parse;
+    // they are retried on the next refresh.
+    template<class F>
+    std::size_t refresh(const std::vector<parse_job>& jobs, F f, parallel_options opts={})
+    {
+        std::mutex m;
+        detail::file_hash_cache cache;
+        return parallel_parse(this->get_stale_jobs(jobs), [&](const parse_job& job, translation_unit& tu)
+        {
+            auto deps = get_dependencies(tu, job, cache);
+            f(job, tu);
+            std::lock_guard<std::mutex> lock(m);
+            records[job.filename] = std::move(deps);
+        }, opts);
+    }
+
+    void save(const std::string& path) const
+    {
+        std::ofstream os(path);
+        os << "clangpp-incremental 1\n";
+        for(auto&& p:records)
+        {
+            os << "tu " << p.second.command_hash << ' ' << p.second.files.size() << ' ' << p.first << '\n';
+            for(auto&& d:p.second.files)
+            {
+                os << "dep " << d.id.data[0] << ' ' << d.id.data[1] << ' ' << d.id.data[2] << ' '
+                    << static_cast<long long>(d.time) << ' ' << d.hash << ' ' << d.name << '\n';
+            }
+        }
+        if (!os) throw std::runtime_error("Incremental index can't be saved: " + path);
+    }
+
+    // A missing or unreadable file leaves the index empty, so everything is
+    // reparsed
+    void load(const std::string& path)
+    {
+        records.clear();
+        std::ifstream is(path);
+        std::string line;
+        if (!std::getline(is, line) || line != "clangpp-incremental 1") return;
+        tu_dependencies * current = nullptr;
+        while(std::getline(is, line))
+        {
+            std::istringstream ls(line);
+            std::string tag;
+            ls >> tag;
+            if (tag == "tu")
+            {
+                tu_dependencies deps;
+                std::size_t n;
+                ls >> deps.command_hash >> n;
+                std::string name;
+                std::getline(ls >> std::ws, name);
+                current = &(records[name] = std::move(deps));
+            }
+            else if (tag == "dep" && current != nullptr)
+            {
+                file_dependency d;
+                long long time;
+                ls >> d.id.data[0] >> d.id.data[1] >> d.id.data[2] >> time >> d.hash;
+                std::getline(ls >> std::ws, d.name);
+                d.time = time;
+                current->files.push_back(std::move(d));
+            }
+        }
+    }
+};
+
+}
+
+#endif
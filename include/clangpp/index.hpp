@@ -0,0 +1,197 @@
+#ifndef LIBCLANGPP_INDEX_H
+#define LIBCLANGPP_INDEX_H
+
+#include <clangpp/translation_unit.hpp>
+#include <utility>
+#include <vector>
+#include <clang-c/Index.h>
+
+namespace clang {
+
+enum class parse_profile
+{
+    // Everything, including the detailed preprocessing record of macro
+    // definitions, expansions and inclusion directives
+    full,
+    // clang_defaultEditingTranslationUnitOptions: a precompiled preamble and
+    // cached completion results, tuned for repeated reparsing in an editor
+    editing,
+    // Omits function bodies and the detailed preprocessing record, and keeps
+    // going after fatal errors such as missing headers; top-level
+    // declarations, types and signatures are all still available
+    declarations_only,
+    // Parses only the main file without following includes, and omits
+    // function bodies; good enough for tokens, comments and the shape of
+    // the file, but names declared in headers are unresolved
+    lexical_only
+};
+
+inline unsigned get_parse_options(parse_profile p)
+{
+    switch(p)
+    {
+        case parse_profile::full: return CXTranslationUnit_DetailedPreprocessingRecord;
+        case parse_profile::editing: return CLANGPP_CALL(clang_defaultEditingTranslationUnitOptions)();
+#if CINDEX_VERSION_MINOR >= 43
+        case parse_profile::declarations_only: return CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_KeepGoing;
+        case parse_profile::lexical_only: return CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_KeepGoing | CXTranslationUnit_SingleFileParse;
+#else
+        case parse_profile::declarations_only:
+        case parse_profile::lexical_only: return CXTranslationUnit_SkipFunctionBodies;
+#endif
+    }
+    return CXTranslationUnit_None;
+}
+
+struct index
+{
+    CLANGPP_UNIQUE_PTR(CXIndex, clang_disposeIndex) self;
+    index() : self(CLANGPP_CALL(clang_createIndex)(1, 1))
+    {}
+    index(CXIndex s) : self(s)
+    {}
+    index(int exclude_declarations_from_pch, int display_diagnostics) : self(CLANGPP_CALL(clang_createIndex)(exclude_declarations_from_pch, display_diagnostics))
+    {}
+    struct action
+    {
+        CLANGPP_UNIQUE_PTR(CXIndexAction, clang_IndexAction_dispose) self;
+        action(CXIndexAction s) : self(s)
+        {}
+        int index_source_file(CXClientData client_data, IndexerCallbacks * index_callbacks, unsigned index_callbacks_size, unsigned index_options, const char * source_filename, const char * const * command_line_args, int num_command_line_args, CXUnsavedFile * unsaved_files, unsigned num_unsaved_files, CXTranslationUnit * out_tu, unsigned tu_options)
+        {
+            return CLANGPP_CALL(clang_indexSourceFile)(self.get(), client_data, index_callbacks, index_callbacks_size, index_options, source_filename, command_line_args, num_command_line_args, unsaved_files, num_unsaved_files, out_tu, tu_options);
+        }
+        int index_translation_unit(CXClientData client_data, IndexerCallbacks * index_callbacks, unsigned index_callbacks_size, unsigned index_options, translation_unit translation_unit_var)
+        {
+            return CLANGPP_CALL(clang_indexTranslationUnit)(self.get(), client_data, index_callbacks, index_callbacks_size, index_options, translation_unit_var.self.get());
+        }
+    };
+    void set_global_options(unsigned options)
+    {
+        CLANGPP_CALL(clang_CXIndex_setGlobalOptions)(self.get(), options);
+    }
+    unsigned get_global_options()
+    {
+        return CLANGPP_CALL(clang_CXIndex_getGlobalOptions)(self.get());
+    }
+    translation_unit create_translation_unit_from_source_file(string_view source_filename, int num_clang_command_line_args, const char * const * clang_command_line_args, unsigned num_unsaved_files, CXUnsavedFile * unsaved_files)
+    {
+        return CLANGPP_CALL(clang_createTranslationUnitFromSourceFile)(self.get(), source_filename.c_str(), num_clang_command_line_args, clang_command_line_args, num_unsaved_files, unsaved_files);
+    }
+    translation_unit create_translation_unit(string_view ast_filename)
+    {
+        auto result = this->try_create_translation_unit(ast_filename);
+        if (!result) CLANGPP_THROW_ERROR(result.error());
+        return std::move(*result);
+    }
+    translation_unit parse_translation_unit(string_view source_filename, std::vector<const char *> args={}, std::vector<CXUnsavedFile> unsaved_files={}, unsigned options=CLANGPP_CALL(clang_defaultEditingTranslationUnitOptions)())
+    {
+        return this->parse_translation_unit(source_filename, args.data(), args.size(), unsaved_files.data(), unsaved_files.size(), options);
+    }
+    translation_unit parse_translation_unit(string_view source_filename, parse_profile profile, std::vector<const char *> args={}, std::vector<CXUnsavedFile> unsaved_files={})
+    {
+        return this->parse_translation_unit(source_filename, args.data(), args.size(), unsaved_files.data(), unsaved_files.size(), get_parse_options(profile));
+    }
+    translation_unit parse_translation_unit(string_view source_filename, const char *const * command_line_args, int num_command_line_args, CXUnsavedFile * unsaved_files, unsigned num_unsaved_files, unsigned options)
+    {
+        auto result = this->try_parse_translation_unit(source_filename, command_line_args, num_command_line_args, unsaved_files, num_unsaved_files, options);
+        if (!result) CLANGPP_THROW_ERROR(result.error());
+        return std::move(*result);
+    }
+    translation_unit parse_translation_unit_full_argv(string_view source_filename, const char *const * command_line_args, int num_command_line_args, CXUnsavedFile * unsaved_files, unsigned num_unsaved_files, unsigned options)
+    {
+        auto result = this->try_parse_translation_unit_full_argv(source_filename, command_line_args, num_command_line_args, unsaved_files, num_unsaved_files, options);
+        if (!result) CLANGPP_THROW_ERROR(result.error());
+        return std::move(*result);
+    }
+    // The try_ variants return the error code instead of throwing, and do not
+    // allocate when they fail
+    expected<translation_unit> try_create_translation_unit(string_view ast_filename)
+    {
+        CXTranslationUnit out_tu;
+        auto e = CLANGPP_CALL(clang_createTranslationUnit2)(self.get(), ast_filename.c_str(), &out_tu);
+        if (e != CXError_Success) return e;
+        return translation_unit{out_tu};
+    }
+    expected<translation_unit> try_parse_translation_unit(string_view source_filename, const char *const * command_line_args, int num_command_line_args, CXUnsavedFile * unsaved_files, unsigned num_unsaved_files, unsigned options)
+    {
+        CXTranslationUnit out_tu;
+        auto e = CLANGPP_CALL(clang_parseTranslationUnit2)(self.get(), source_filename.c_str(), command_line_args, num_command_line_args, unsaved_files, num_unsaved_files, options, &out_tu);
+        if (e != CXError_Success) return e;
+        return translation_unit{out_tu};
+    }
+    expected<translation_unit> try_parse_translation_unit_full_argv(string_view source_filename, const char *const * command_line_args, int num_command_line_args, CXUnsavedFile * unsaved_files, unsigned num_unsaved_files, unsigned options)
+    {
+        CXTranslationUnit out_tu;
+        auto e = CLANGPP_CALL(clang_parseTranslationUnit2FullArgv)(self.get(), source_filename.c_str(), command_line_args, num_command_line_args, unsaved_files, num_unsaved_files, options, &out_tu);
+        if (e != CXError_Success) return e;
+        return translation_unit{out_tu};
+    }
+    action create()
+    {
+        return CLANGPP_CALL(clang_IndexAction_create)(self.get());
+    }
+};
+
+inline string get_version()
+{
+    return CLANGPP_CALL(clang_getClangVersion)();
+}
+
+struct idx_loc
+{
+    CXIdxLoc self;
+    void get_file_location(CXIdxClientFile * index_file, CXFile * file, unsigned * line, unsigned * column, unsigned * offset)
+    {
+        CLANGPP_CALL(clang_indexLoc_getFileLocation)(self, index_file, file, line, column, offset);
+    }
+    source_location get_cx_source_location()
+    {
+        return CLANGPP_CALL(clang_indexLoc_getCXSourceLocation)(self);
+    }
+};
+struct remapping
+{
+    CXRemapping self;
+    remapping(const char * path) : self(CLANGPP_CALL(clang_getRemappings)(path))
+    {}
+    remapping(const char ** file_paths, unsigned num_files) : self(CLANGPP_CALL(clang_getRemappingsFromFileList)(file_paths, num_files))
+    {}
+    remapping(const remapping&)=delete;
+    remapping& operator=(const remapping&)=delete;
+    ~remapping()
+    {
+        CLANGPP_CALL(clang_remap_dispose)(self);
+    }
+    unsigned get_num_files()
+    {
+        return CLANGPP_CALL(clang_remap_getNumFiles)(self);
+    }
+    void get_filenames(unsigned index, CXString * original, CXString * transformed)
+    {
+        CLANGPP_CALL(clang_remap_getFilenames)(self, index, original, transformed);
+    }
+};
+
+struct virtual_file_overlay
+{
+    CLANGPP_UNIQUE_PTR(CXVirtualFileOverlay, clang_VirtualFileOverlay_dispose) self;
+    virtual_file_overlay(unsigned options) : self(CLANGPP_CALL(clang_VirtualFileOverlay_create)(options))
+    {}
+    CXErrorCode add_file_mapping(const char * virtual_path, const char * real_path)
+    {
+        return CLANGPP_CALL(clang_VirtualFileOverlay_addFileMapping)(self.get(), virtual_path, real_path);
+    }
+    CXErrorCode set_case_sensitivity(int case_sensitive)
+    {
+        return CLANGPP_CALL(clang_VirtualFileOverlay_setCaseSensitivity)(self.get(), case_sensitive);
+    }
+    CXErrorCode write_to_buffer(unsigned options, char ** out_buffer_ptr, unsigned * out_buffer_size)
+    {
+        return CLANGPP_CALL(clang_VirtualFileOverlay_writeToBuffer)(self.get(), options, out_buffer_ptr, out_buffer_size);
+    }
+};
+
+}
+
+#endif
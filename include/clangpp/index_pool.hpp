@@ -0,0 +1,79 @@
+#ifndef LIBCLANGPP_INDEX_POOL_H
+#define LIBCLANGPP_INDEX_POOL_H
+
+#include <clangpp/index.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace clang {
+
+struct index_options
+{
+    bool exclude_declarations_from_pch = false;
+    // Printing every diagnostic to stderr is slow for bulk runs, so it is off
+    bool display_diagnostics = false;
+    // CXGlobalOptFlags, such as CXGlobalOpt_ThreadBackgroundPriorityForIndexing
+    unsigned global_options = CXGlobalOpt_None;
+};
+
+inline std::unique_ptr<index> make_index(const index_options& opts)
+{
+    std::unique_ptr<index> result{new index(opts.exclude_declarations_from_pch, opts.display_diagnostics)};
+    if (opts.global_options != CXGlobalOpt_None) result->set_global_options(opts.global_options);
+    return result;
+}
+
+// Lazily creates one index per thread, so a thread pool can parse concurrently
+// without sharing an index. The indices live as long as the pool.
+struct index_pool
+{
+    index_options opts;
+
+    index_pool(index_options o={}) : opts(o), id(next_id()++)
+    {}
+
+    index_pool(const index_pool&)=delete;
+    index_pool& operator=(const index_pool&)=delete;
+
+    index& get()
+    {
+        // Each thread remembers the last index it got, so only the first call
+        // on a thread takes the lock
+        struct cache
+        {
+            std::size_t id;
+            index * idx;
+        };
+        thread_local cache last = {0, nullptr};
+        if (last.id == id) return *last.idx;
+        std::lock_guard<std::mutex> lock(m);
+        auto&& p = indices[std::this_thread::get_id()];
+        if (p == nullptr) p = make_index(opts);
+        last = {id, p.get()};
+        return *p;
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return indices.size();
+    }
+
+private:
+    static std::atomic<std::size_t>& next_id()
+    {
+        static std::atomic<std::size_t> result{1};
+        return result;
+    }
+
+    std::size_t id;
+    std::mutex m;
+    std::unordered_map<std::thread::id, std::unique_ptr<index>> indices;
+};
+
+}
+
+#endif
@@ -0,0 +1,538 @@
+#ifndef LIBCLANGPP_JSON_COMPILATION_DATABASE_H
+#define LIBCLANGPP_JSON_COMPILATION_DATABASE_H
+
+#include <clangpp/parallel.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clang {
+
+namespace detail {
+
+// Removes "." components, empty components and "dir/.." pairs
+inline std::string normalize_path(const std::string& path)
+{
+    bool absolute = !path.empty() && path[0] == '/';
+    std::string result = absolute ? "/" : "";
+    result.reserve(path.size());
+    // Everything before floor is a root or ".." components that stay
+    std::size_t floor = result.size();
+    for(std::size_t start = 0; start <= path.size();)
+    {
+        auto end = path.find('/', start);
+        if (end == std::string::npos) end = path.size();
+        auto n = end - start;
+        bool dot = n == 1 && path[start] == '.';
+        bool dot_dot = n == 2 && path[start] == '.' && path[start + 1] == '.';
+        if (dot_dot && result.size() > floor)
+        {
+            auto slash = result.rfind('/');
+            result.resize(slash == std::string::npos || slash < floor ? floor : slash);
+        }
+        else if (n > 0 && !dot && !(dot_dot && absolute))
+        {
+            if (!result.empty() && result.back() != '/') result += '/';
+            result.append(path, start, n);
+            if (dot_dot) floor = result.size();
+        }
+        start = end + 1;
+    }
+    return result.empty() ? "." : result;
+}
+
+inline std::string get_absolute_path(const std::string& directory, const std::string& file)
+{
+    if (file.empty() || file[0] == '/' || directory.empty()) return normalize_path(file);
+    return normalize_path(directory + "/" + file);
+}
+
+// Splits a shell command line the way the JSON compilation database does:
+// on unquoted whitespace, with single quotes, double quotes and backslash
+// escapes
+inline std::vector<std::string> split_command(const std::string& command)
+{
+    std::vector<std::string> result;
+    std::string arg;
+    bool in_arg = false;
+    char quote = 0;
+    for(std::size_t i = 0; i < command.size(); i++)
+    {
+        char c = command[i];
+        if (quote == '\'')
+        {
+            if (c == '\'') quote = 0;
+            else arg += c;
+        }
+        else if (c == '\\' && i + 1 < command.size() && (quote == 0 || std::strchr("\"\\$`", command[i + 1]) != nullptr))
+        {
+            arg += command[++i];
+            in_arg = true;
+        }
+        else if (quote == '"')
+        {
+            if (c == '"') quote = 0;
+            else arg += c;
+        }
+        else if (c == '\'' || c == '"')
+        {
+            quote = c;
+            in_arg = true;
+        }
+        else if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        {
+            if (in_arg) result.push_back(std::move(arg));
+            arg.clear();
+            in_arg = false;
+        }
+        else
+        {
+            arg += c;
+            in_arg = true;
+        }
+    }
+    if (in_arg) result.push_back(std::move(arg));
+    return result;
+}
+
+struct mapped_file
+{
+    const char * data = nullptr;
+    std::size_t size = 0;
+
+    mapped_file(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Database can't be loaded: " + path);
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            size = st.st_size;
+            void * p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) data = static_cast<const char *>(p);
+        }
+        close(fd);
+        if (data == nullptr) throw std::runtime_error("Database can't be loaded: " + path);
+    }
+    mapped_file(const mapped_file&)=delete;
+    mapped_file& operator=(const mapped_file&)=delete;
+    ~mapped_file()
+    {
+        munmap(const_cast<char *>(data), size);
+    }
+};
+
+// A single pass over the JSON text; strings are decoded straight into the
+// arena of a string_table
+struct json_reader
+{
+    const char * first;
+    const char * pos;
+    const char * last;
+
+    json_reader(const char * data, std::size_t n) : first(data), pos(data), last(data + n)
+    {}
+
+    [[noreturn]] void fail(const char * what) const
+    {
+        throw std::runtime_error(std::string("Database can't be loaded: ") + what + " at offset " + std::to_string(pos - first));
+    }
+
+    void skip_space()
+    {
+        while(pos != last && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) pos++;
+    }
+
+    char peek()
+    {
+        skip_space();
+        if (pos == last) fail("unexpected end");
+        return *pos;
+    }
+
+    void expect(char c)
+    {
+        if (peek() != c) fail("unexpected character");
+        pos++;
+    }
+
+    bool consume(char c)
+    {
+        if (peek() != c) return false;
+        pos++;
+        return true;
+    }
+
+    static void append_utf8(std::vector<char>& out, std::uint32_t c)
+    {
+        if (c < 0x80)
+        {
+            out.push_back(c);
+        }
+        else if (c < 0x800)
+        {
+            out.push_back(0xC0 | (c >> 6));
+            out.push_back(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            out.push_back(0xE0 | (c >> 12));
+            out.push_back(0x80 | ((c >> 6) & 0x3F));
+            out.push_back(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            out.push_back(0xF0 | (c >> 18));
+            out.push_back(0x80 | ((c >> 12) & 0x3F));
+            out.push_back(0x80 | ((c >> 6) & 0x3F));
+            out.push_back(0x80 | (c & 0x3F));
+        }
+    }
+
+    std::uint32_t read_hex4()
+    {
+        if (last - pos < 4) fail("bad escape");
+        std::uint32_t result = 0;
+        for(int i = 0; i < 4; i++, pos++)
+        {
+            char c = *pos;
+            result <<= 4;
+            if (c >= '0' && c <= '9') result |= c - '0';
+            else if (c >= 'a' && c <= 'f') result |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') result |= c - 'A' + 10;
+            else fail("bad escape");
+        }
+        return result;
+    }
+
+    // Appends the decoded string to out
+    void read_string(std::vector<char>& out)
+    {
+        expect('"');
+        for(;;)
+        {
+            auto run = pos;
+            while(pos != last && *pos != '"' && *pos != '\\') pos++;
+            out.insert(out.end(), run, pos);
+            if (pos == last) fail("unterminated string");
+            if (*pos++ == '"') return;
+            if (pos == last) fail("unterminated string");
+            char c = *pos++;
+            switch(c)
+            {
+                case '"': case '\\': case '/': out.push_back(c); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u':
+                {
+                    auto code = read_hex4();
+                    if (code >= 0xD800 && code < 0xDC00 && last - pos >= 6 && pos[0] == '\\' && pos[1] == 'u')
+                    {
+                        pos += 2;
+                        auto low = read_hex4();
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    append_utf8(out, code);
+                    break;
+                }
+                default: fail("bad escape");
+            }
+        }
+    }
+
+    std::string read_std_string()
+    {
+        std::vector<char> buffer;
+        read_string(buffer);
+        return {buffer.begin(), buffer.end()};
+    }
+
+    void skip_value()
+    {
+        char c = peek();
+        if (c == '"')
+        {
+            std::vector<char> ignored;
+            read_string(ignored);
+        }
+        else if (c == '{' || c == '[')
+        {
+            char close = c == '{' ? '}' : ']';
+            pos++;
+            if (consume(close)) return;
+            do
+            {
+                if (c == '{')
+                {
+                    skip_value();
+                    expect(':');
+                }
+                skip_value();
+            } while(consume(','));
+            expect(close);
+        }
+        else
+        {
+            auto start = pos;
+            while(pos != last && std::strchr(",}] \t\r\n", *pos) == nullptr) pos++;
+            if (pos == start) fail("expected a value");
+        }
+    }
+};
+
+}
+
+// compile_commands.json loaded without libclang. The file is memory-mapped
+// and parsed in one pass; every directory, file name and argument is
+// interned, so an argument shared by many commands is stored once, and the
+// commands of a file are found through a hash of its absolute path.
+struct json_compilation_database
+{
+    struct command_entry
+    {
+        std::uint32_t directory;
+        std::uint32_t filename;
+        std::uint32_t first_arg;
+        std::uint32_t num_args;
+    };
+
+    struct command
+    {
+        const json_compilation_database * db;
+        std::uint32_t index;
+
+        const char * get_directory() const
+        {
+            return db->strings.get(db->commands[index].directory);
+        }
+        const char * get_filename() const
+        {
+            return db->strings.get(db->commands[index].filename);
+        }
+        std::size_t get_num_args() const
+        {
+            return db->commands[index].num_args;
+        }
+        const char * get_arg(std::size_t i) const
+        {
+            return db->strings.get(db->args[db->commands[index].first_arg + i]);
+        }
+        auto get_args() const
+        {
+            auto self = *this;
+            return detail::make_index_range(0, this->get_num_args(), [self](std::size_t i)
+            {
+                return self.get_arg(i);
+            });
+        }
+    };
+
+    detail::string_table strings;
+    std::vector<command_entry> commands;
+    std::vector<std::uint32_t> args;
+    // Indices into commands, grouped by file
+    std::vector<std::uint32_t> by_file;
+    // For each interned string that is an absolute file path, the range in
+    // by_file of its commands
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> file_ranges;
+
+    json_compilation_database(string_view build_dir)
+    {
+        detail::mapped_file f{std::string(build_dir.c_str()) + "/compile_commands.json"};
+        this->load(f.data, f.size);
+    }
+
+    static json_compilation_database from_file(const std::string& path)
+    {
+        json_compilation_database result;
+        detail::mapped_file f{path};
+        result.load(f.data, f.size);
+        return result;
+    }
+
+    static json_compilation_database from_buffer(const char * data, std::size_t n)
+    {
+        json_compilation_database result;
+        result.load(data, n);
+        return result;
+    }
+
+    std::size_t size() const
+    {
+        return commands.size();
+    }
+
+    command operator()(std::size_t i) const
+    {
+        return {this, std::uint32_t(i)};
+    }
+
+    auto get_all_compile_commands() const
+    {
+        return detail::make_index_range(0, this->size(), [this](std::size_t i)
+        {
+            return (*this)(i);
+        });
+    }
+
+    // The commands of a file, by absolute path; relative paths in the
+    // database are resolved against their directory
+    auto get_compile_commands(string_view complete_file_name) const
+    {
+        std::pair<std::uint32_t, std::uint32_t> range{0, 0};
+        auto path = detail::normalize_path(complete_file_name.c_str());
+        auto id = strings.find(path.data(), path.size());
+        if (id != detail::string_table::npos && id < file_ranges.size()) range = file_ranges[id];
+        return detail::make_index_range(range.first, range.second, [this](std::size_t i)
+        {
+            return (*this)(by_file[i]);
+        });
+    }
+
+    auto operator[](string_view complete_file_name) const
+    {
+        return this->get_compile_commands(complete_file_name);
+    }
+
+private:
+    json_compilation_database()
+    {}
+
+    void load(const char * data, std::size_t n)
+    {
+        std::vector<std::uint32_t> paths;
+        detail::json_reader r{data, n};
+        r.expect('[');
+        if (!r.consume(']'))
+        {
+            do
+            {
+                paths.push_back(this->read_command(r));
+            } while(r.consume(','));
+            r.expect(']');
+        }
+        r.skip_space();
+        if (r.pos != r.last) r.fail("trailing characters");
+        this->build_index(paths);
+    }
+
+    std::uint32_t intern_string(detail::json_reader& r)
+    {
+        auto offset = strings.arena.size();
+        r.read_string(strings.arena);
+        return strings.intern_tail(offset);
+    }
+
+    // Returns the id of the absolute path of the command's file
+    std::uint32_t read_command(detail::json_reader& r)
+    {
+        command_entry e = {0, 0, std::uint32_t(args.size()), 0};
+        bool has_directory = false;
+        bool has_file = false;
+        bool has_args = false;
+        std::string command_line;
+        r.expect('{');
+        if (!r.consume('}'))
+        {
+            do
+            {
+                auto key = r.read_std_string();
+                r.expect(':');
+                if (key == "directory")
+                {
+                    e.directory = this->intern_string(r);
+                    has_directory = true;
+                }
+                else if (key == "file")
+                {
+                    e.filename = this->intern_string(r);
+                    has_file = true;
+                }
+                else if (key == "arguments")
+                {
+                    // Arguments take precedence over a command
+                    args.resize(e.first_arg);
+                    r.expect('[');
+                    if (!r.consume(']'))
+                    {
+                        do
+                        {
+                            args.push_back(this->intern_string(r));
+                        } while(r.consume(','));
+                        r.expect(']');
+                    }
+                    has_args = true;
+                }
+                else if (key == "command" && !has_args)
+                {
+                    command_line = r.read_std_string();
+                }
+                else
+                {
+                    r.skip_value();
+                }
+            } while(r.consume(','));
+            r.expect('}');
+        }
+        if (!has_directory || !has_file) r.fail("missing directory or file");
+        if (!has_args)
+        {
+            for(auto&& arg:detail::split_command(command_line)) args.push_back(strings.intern(arg));
+        }
+        e.num_args = args.size() - e.first_arg;
+        commands.push_back(e);
+        return strings.intern(detail::get_absolute_path(strings.get(e.directory), strings.get(e.filename)));
+    }
+
+    void build_index(const std::vector<std::uint32_t>& paths)
+    {
+        by_file.resize(commands.size());
+        for(std::uint32_t i = 0; i < by_file.size(); i++) by_file[i] = i;
+        std::stable_sort(by_file.begin(), by_file.end(), [&](std::uint32_t x, std::uint32_t y)
+        {
+            return paths[x] < paths[y];
+        });
+        std::uint32_t max_id = 0;
+        for(auto p:paths) max_id = std::max(max_id, p + 1);
+        file_ranges.assign(max_id, {0, 0});
+        for(std::uint32_t i = 0; i < by_file.size();)
+        {
+            auto p = paths[by_file[i]];
+            std::uint32_t j = i;
+            while(j < by_file.size() && paths[by_file[j]] == p) j++;
+            file_ranges[p] = {i, j};
+            i = j;
+        }
+    }
+};
+
+inline std::vector<parse_job> get_parse_jobs(const json_compilation_database& db)
+{
+    std::vector<parse_job> result;
+    result.reserve(db.size());
+    for(auto cc:db.get_all_compile_commands())
+    {
+        parse_job job;
+        job.directory = cc.get_directory();
+        job.filename = cc.get_filename();
+        job.args.reserve(cc.get_num_args());
+        for(auto arg:cc.get_args()) job.args.push_back(arg);
+        result.push_back(std::move(job));
+    }
+    return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef LIBCLANGPP_LOCATION_H
+#define LIBCLANGPP_LOCATION_H
+
+#include <clangpp/string.hpp>
+#include <ctime>
+#include <tuple>
+#include <clang-c/Index.h>
+
+namespace clang {
+
+struct file
+{
+    CXFile self;
+    file()
+    {}
+    file(CXFile s) : self(s)
+    {}
+    string get_file_name()
+    {
+        return CLANGPP_CALL(clang_getFileName)(self);
+    }
+    time_t get_file_time()
+    {
+        return CLANGPP_CALL(clang_getFileTime)(self);
+    }
+    CXFileUniqueID get_file_unique_id()
+    {
+        CXFileUniqueID result;
+        int err = CLANGPP_CALL(clang_getFileUniqueID)(self, &result);
+        if (err != 0) throw std::runtime_error("Unique ID failed");
+        return result;
+    }
+    bool is_equal(file rhs)
+    {
+        return CLANGPP_CALL(clang_File_isEqual)(self, rhs.self);
+    }
+};
+struct file_location : file
+{
+    unsigned line;
+    unsigned column;
+    unsigned offset;
+};
+
+struct source_location
+{
+    CXSourceLocation self;
+    source_location() : self(CLANGPP_CALL(clang_getNullLocation)())
+    {}
+    source_location(CXSourceLocation l) : self(l)
+    {}
+    bool equal_locations(source_location loc2)
+    {
+        return CLANGPP_CALL(clang_equalLocations)(self, loc2.self);
+    }
+    bool is_in_system_header()
+    {
+        return CLANGPP_CALL(clang_Location_isInSystemHeader)(self);
+    }
+    bool is_from_main_file()
+    {
+        return CLANGPP_CALL(clang_Location_isFromMainFile)(self);
+    }
+
+    void get_presumed_location(CXString * filename, unsigned * line, unsigned * column)
+    {
+        CLANGPP_CALL(clang_getPresumedLocation)(self, filename, line, column);
+    }
+    file_location get_expansion_location()
+    {
+        file_location result;
+        CLANGPP_CALL(clang_getExpansionLocation)(self, &result.self, &result.line, &result.column, &result.offset);
+        return result;
+    }
+    std::tuple<string, unsigned, unsigned> get_presumed_location()
+    {
+        string filename;
+        unsigned line;
+        unsigned column;
+        CLANGPP_CALL(clang_getPresumedLocation)(self, &filename.self, &line, &column);
+        return std::make_tuple(std::move(filename), line, column);
+    }
+    file_location get_instantiation_location()
+    {
+        file_location result;
+        CLANGPP_CALL(clang_getInstantiationLocation)(self, &result.self, &result.line, &result.column, &result.offset);
+        return result;
+    }
+    file_location get_spelling_location()
+    {
+        file_location result;
+        CLANGPP_CALL(clang_getSpellingLocation)(self, &result.self, &result.line, &result.column, &result.offset);
+        return result;
+    }
+    file_location get_file_location()
+    {
+        file_location result;
+        CLANGPP_CALL(clang_getFileLocation)(self, &result.self, &result.line, &result.column, &result.offset);
+        return result;
+    }
+};
+struct source_range
+{
+    CXSourceRange self;
+    source_range() : self(CLANGPP_CALL(clang_getNullRange)())
+    {}
+    source_range(CXSourceRange r) : self(r)
+    {}
+    source_range(source_location start, source_location end) : self(CLANGPP_CALL(clang_getRange)(start.self, end.self))
+    {}
+    bool equal_ranges(source_range range2)
+    {
+        return CLANGPP_CALL(clang_equalRanges)(self, range2.self);
+    }
+    bool is_null()
+    {
+        return CLANGPP_CALL(clang_Range_isNull)(self);
+    }
+    source_location get_range_start()
+    {
+        return CLANGPP_CALL(clang_getRangeStart)(self);
+    }
+    source_location get_range_end()
+    {
+        return CLANGPP_CALL(clang_getRangeEnd)(self);
+    }
+};
+
+}
+
+#endif
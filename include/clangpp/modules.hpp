@@ -0,0 +1,214 @@
+#ifndef LIBCLANGPP_MODULES_H
+#define LIBCLANGPP_MODULES_H
+
+#include <clangpp/cursor.hpp>
+#include <clangpp/translation_unit.hpp>
+#include <clangpp/parallel.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+
+namespace clang {
+
+// An implicit module cache shared by every parse in a pool. All parses use
+// the same cache path and build session, so a module built by one worker is
+// reused by the others, and each module is only validated against its
+// inputs once per session instead of once per parse.
+struct module_cache
+{
+    std::string path;
+    // Seconds since the epoch; modules validated after it are trusted
+    long long session;
+
+    module_cache(std::string p) : path(std::move(p)), session(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count())
+    {}
+
+    module_cache(std::string p, long long s) : path(std::move(p)), session(s)
+    {}
+
+    std::vector<std::string> get_args() const
+    {
+        return {
+            "-fmodules",
+            "-fmodules-cache-path=" + path,
+            "-fbuild-session-timestamp=" + std::to_string(session),
+            "-fmodules-validate-once-per-build-session"
+        };
+    }
+
+    // Inserts the module arguments after the compiler
+    void add_args(parse_job& job) const
+    {
+        auto args = get_args();
+        job.args.insert(job.args.begin() + (job.args.empty() ? 0 : 1), args.begin(), args.end());
+    }
+
+    std::vector<parse_job> add_args(std::vector<parse_job> jobs) const
+    {
+        for(auto&& job:jobs) add_args(job);
+        return jobs;
+    }
+};
+
+struct module_use
+{
+    std::string name;
+    std::string ast_file;
+    // The module file was written while the translation unit was parsed,
+    // either by this parse or by another worker it waited for
+    bool rebuilt;
+};
+
+struct module_report
+{
+    std::vector<module_use> modules;
+
+    std::size_t hits() const
+    {
+        std::size_t result = 0;
+        for(auto&& m:modules) result += !m.rebuilt;
+        return result;
+    }
+
+    std::size_t rebuilds() const
+    {
+        return modules.size() - hits();
+    }
+};
+
+namespace detail {
+
+inline long long get_module_clock()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+inline long long get_file_mtime(const std::string& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return 0;
+#ifdef __APPLE__
+    return st.st_mtimespec.tv_sec * 1000000000ll + st.st_mtimespec.tv_nsec;
+#else
+    return st.st_mtim.tv_sec * 1000000000ll + st.st_mtim.tv_nsec;
+#endif
+}
+
+inline module get_top_level_module(module m)
+{
+    for(auto parent = m.get_parent(); parent.self != nullptr; parent = m.get_parent()) m = parent;
+    return m;
+}
+
+}
+
+// Lists the top-level modules the translation unit loaded, both imported
+// explicitly and through headers that belong to a module. parse_start is
+// the time, from detail::get_module_clock, at which the parse began; a
+// module file modified after it counts as a rebuild.
+inline module_report get_module_report(translation_unit& tu, long long parse_start)
+{
+    std::vector<CXModule> found;
+    for(auto c:tu.get_translation_unit_cursor().children())
+    {
+        if (c.get_kind() == CXCursor_ModuleImportDecl && c.get_module().self != nullptr) found.push_back(c.get_module().self);
+    }
+    std::vector<CXFile> files;
+    CXInclusionVisitor visitor = [](CXFile f, CXSourceLocation *, unsigned, CXClientData data)
+    {
+        reinterpret_cast<std::vector<CXFile>*>(data)->push_back(f);
+    };
+    tu.get_inclusions(visitor, &files);
+    for(auto f:files)
+    {
+        auto m = tu.get_module_for_file(f);
+        if (m.self != nullptr) found.push_back(m.self);
+    }
+
+    module_report result;
+    std::unordered_set<CXModule> seen;
+    for(auto m:found)
+    {
+        auto top = detail::get_top_level_module(m);
+        if (!seen.insert(top.self).second) continue;
+        auto ast = top.get_ast_file();
+        if (ast.self == nullptr) continue;
+        auto ast_file = ast.get_file_name().to_std_string();
+        bool rebuilt = detail::get_file_mtime(ast_file) >= parse_start;
+        result.modules.push_back({top.get_full_name().to_std_string(), std::move(ast_file), rebuilt});
+    }
+    return result;
+}
+
+struct module_stats
+{
+    std::atomic<std::size_t> hits{0};
+    std::atomic<std::size_t> rebuilds{0};
+
+    double hit_rate() const
+    {
+        std::size_t total = hits + rebuilds;
+        return total == 0 ? 0.0 : double(hits) / total;
+    }
+};
+
+// Parses every job in parallel with the module cache, and calls
+// f(job, tu, report) with the modules each translation unit loaded. The
+// totals are added to stats. A translation unit is taken to start parsing
+// when the previous one on its thread was handed to f, so a module written
+// after that counts as a rebuild.
+template<class F>
+std::size_t parallel_parse(const std::vector<parse_job>& jobs, F f, const module_cache& cache, module_stats& stats, index_pool& pool, parallel_options opts={})
+{
+    auto module_jobs = cache.add_args(jobs);
+    auto call_start = detail::get_module_clock();
+    std::mutex m;
+    std::unordered_map<std::thread::id, long long> parse_starts;
+    auto get_parse_start = [&]
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = parse_starts.find(std::this_thread::get_id());
+        return it == parse_starts.end() ? call_start : it->second;
+    };
+    auto set_parse_start = [&]
+    {
+        auto now = detail::get_module_clock();
+        std::lock_guard<std::mutex> lock(m);
+        parse_starts[std::this_thread::get_id()] = now;
+    };
+    return parallel_parse(module_jobs, [&](const parse_job& job, translation_unit& tu)
+    {
+        auto report = get_module_report(tu, get_parse_start());
+        stats.hits += report.hits();
+        stats.rebuilds += report.rebuilds();
+        try
+        {
+            f(jobs[&job - module_jobs.data()], tu, report);
+        }
+        catch(...)
+        {
+            set_parse_start();
+            throw;
+        }
+        set_parse_start();
+    }, pool, opts);
+}
+
+template<class F>
+std::size_t parallel_parse(const std::vector<parse_job>& jobs, F f, const module_cache& cache, module_stats& stats, parallel_options opts={})
+{
+    index_pool pool{opts.index_opts};
+    return parallel_parse(jobs, f, cache, stats, pool, opts);
+}
+
+}
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef LIBCLANGPP_PARALLEL_H
+#define LIBCLANGPP_PARALLEL_H
+
+#include <clangpp/compilation_database.hpp>
+#include <clangpp/index.hpp>
+#include <clangpp/index_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/stat.h>
+
+namespace clang {
+
+struct parse_job
+{
+    std::string directory;
+    std::string filename;
+    // Full command line, including the compiler as the first argument
+    std::vector<std::string> args;
+};
+
+inline std::vector<parse_job> get_parse_jobs(const compilation_database& db)
+{
+    std::vector<parse_job> result;
+    for(auto cc:db.get_all_compile_commands())
+    {
+        parse_job job;
+        job.directory = cc.get_directory().to_std_string();
+        job.filename = cc.get_filename().to_std_string();
+        for(auto arg:cc.get_args()) job.args.push_back(string(arg).to_std_string());
+        result.push_back(std::move(job));
+    }
+    return result;
+}
+
+namespace detail {
+
+inline std::uint64_t hash_command(const parse_job& job)
+{
+    auto h = fnv1a(job.directory.data(), job.directory.size());
+    for(auto&& arg:job.args) h = fnv1a(arg.c_str(), arg.size() + 1, h);
+    return h;
+}
+
+inline std::uint64_t get_job_file_size(const parse_job& job)
+{
+    auto path = job.filename;
+    if (!path.empty() && path[0] != '/' && !job.directory.empty()) path = job.directory + "/" + path;
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) return 0;
+    return st.st_size;
+}
+
+}
+
+// The time each job took to parse in earlier runs, keyed by its command
+// line, so the parallel parsers can start the most expensive jobs first and
+// not end on a long tail where one thread parses the biggest translation
+// unit while the others sit idle. Jobs without a history are estimated from
+// the size of their main file, at the average parse time per byte of the
+// jobs that have one.
+struct parse_history
+{
+    struct entry
+    {
+        double seconds;
+        std::uint64_t size;
+    };
+
+    parse_history()
+    {}
+    parse_history(const parse_history&)=delete;
+    parse_history& operator=(const parse_history&)=delete;
+
+    void record(const parse_job& job, double seconds)
+    {
+        auto size = detail::get_job_file_size(job);
+        std::lock_guard<std::mutex> lock(m);
+        auto it = entries.find(detail::hash_command(job));
+        // Averaged with the last run to smooth out noise
+        if (it != entries.end()) it->second = {(it->second.seconds + seconds) / 2, size};
+        else entries.emplace(detail::hash_command(job), entry{seconds, size});
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return entries.size();
+    }
+
+    // Estimated parse time of each job, in seconds
+    std::vector<double> estimate(const std::vector<parse_job>& jobs)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        double total_seconds = 0;
+        double total_size = 0;
+        for(auto&& p:entries)
+        {
+            if (p.second.size == 0) continue;
+            total_seconds += p.second.seconds;
+            total_size += p.second.size;
+        }
+        // About a second per megabyte when there is nothing to go on
+        double rate = total_size > 0 ? total_seconds / total_size : 1e-6;
+        std::vector<double> result;
+        result.reserve(jobs.size());
+        for(auto&& job:jobs)
+        {
+            auto it = entries.find(detail::hash_command(job));
+            if (it != entries.end()) result.push_back(it->second.seconds);
+            else result.push_back(detail::get_job_file_size(job) * rate);
+        }
+        return result;
+    }
+
+    // The order in which to start the jobs, longest first
+    std::vector<std::size_t> get_schedule(const std::vector<parse_job>& jobs)
+    {
+        auto costs = this->estimate(jobs);
+        std::vector<std::size_t> result(jobs.size());
+        std::iota(result.begin(), result.end(), 0);
+        std::stable_sort(result.begin(), result.end(), [&](std::size_t x, std::size_t y)
+        {
+            return costs[x] > costs[y];
+        });
+        return result;
+    }
+
+    bool load(const std::string& path)
+    {
+        std::unique_ptr<FILE, int(*)(FILE*)> f(std::fopen(path.c_str(), "r"), &std::fclose);
+        if (f == nullptr) return false;
+        unsigned long long hash, size;
+        double seconds;
+        std::lock_guard<std::mutex> lock(m);
+        while(std::fscanf(f.get(), "%llx %lf %llu", &hash, &seconds, &size) == 3) entries[hash] = {seconds, size};
+        return std::feof(f.get()) != 0;
+    }
+
+    bool save(const std::string& path)
+    {
+        std::unique_ptr<FILE, int(*)(FILE*)> f(std::fopen(path.c_str(), "w"), &std::fclose);
+        if (f == nullptr) return false;
+        std::lock_guard<std::mutex> lock(m);
+        for(auto&& p:entries)
+        {
+            std::fprintf(f.get(), "%016llx %.6f %llu\n", static_cast<unsigned long long>(p.first), p.second.seconds, static_cast<unsigned long long>(p.second.size));
+        }
+        return std::fflush(f.get()) == 0;
+    }
+private:
+    std::mutex m;
+    std::unordered_map<std::uint64_t, entry> entries;
+};
+
+struct parallel_options
+{
+    unsigned threads = std::thread::hardware_concurrency();
+    unsigned parse_options = CXTranslationUnit_None;
+    index_options index_opts;
+    // When set, jobs that have not started yet are skipped once it becomes true
+    std::atomic<bool> * cancel = nullptr;
+    // When set, jobs are started longest first, and the time each one takes
+    // to parse is recorded
+    parse_history * history = nullptr;
+};
+
+namespace detail {
+
+inline std::vector<const char *> make_argv(const parse_job& job, std::string& working_dir)
+{
+    std::vector<const char *> argv;
+    for(auto&& arg:job.args) argv.push_back(arg.c_str());
+    if (!job.directory.empty())
+    {
+        working_dir = "-working-directory=" + job.directory;
+        argv.insert(argv.begin() + (argv.empty() ? 0 : 1), working_dir.c_str());
+    }
+    return argv;
+}
+
+template<class F>
+void parallel_for(std::size_t n, unsigned threads, F f)
+{
+    if (threads == 0) threads = 1;
+    if (threads > n) threads = n;
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&](unsigned thread_id)
+    {
+        try
+        {
+            for(std::size_t i = next++; i < n; i = next++) f(thread_id, i);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            next = n;
+        }
+    };
+    std::vector<std::thread> pool;
+    for(unsigned t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for(auto&& t:pool) t.join();
+    if (error) std::rethrow_exception(error);
+}
+
+}
+
+inline translation_unit parse_job_translation_unit(index& idx, const parse_job& job, unsigned options)
+{
+    std::string working_dir;
+    auto argv = detail::make_argv(job, working_dir);
+    return idx.parse_translation_unit_full_argv(nullptr, argv.data(), argv.size(), nullptr, 0, options);
+}
+
+inline expected<translation_unit> try_parse_job_translation_unit(index& idx, const parse_job& job, unsigned options)
+{
+    std::string working_dir;
+    auto argv = detail::make_argv(job, working_dir);
+    return idx.try_parse_translation_unit_full_argv(nullptr, argv.data(), argv.size(), nullptr, 0, options);
+}
+
+namespace detail {
+
+inline std::vector<std::size_t> get_parse_schedule(const std::vector<parse_job>& jobs, const parallel_options& opts)
+{
+    if (opts.history != nullptr) return opts.history->get_schedule(jobs);
+    std::vector<std::size_t> result(jobs.size());
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+// Parses the job, and records how long it took in the history
+inline expected<translation_unit> parse_scheduled_job(index& idx, const parse_job& job, const parallel_options& opts)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto result = try_parse_job_translation_unit(idx, job, opts.parse_options);
+    if (result && opts.history != nullptr) opts.history->record(job, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return result;
+}
+
+}
+
+// Parses every job on a pool of threads, each thread with its own index from
+// the pool, and calls f(job, tu) for each translation unit that parsed
+// successfully. Returns the number of jobs that failed to parse.
+template<class F>
+std::size_t parallel_parse(const std::vector<parse_job>& jobs, F f, index_pool& pool, parallel_options opts={})
+{
+    std::atomic<std::size_t> failures{0};
+    auto schedule = detail::get_parse_schedule(jobs, opts);
+    detail::parallel_for(jobs.size(), opts.threads, [&](unsigned, std::size_t k)
+    {
+        auto i = schedule[k];
+        if (opts.cancel != nullptr && *opts.cancel) return;
+        auto tu = detail::parse_scheduled_job(pool.get(), jobs[i], opts);
+        if (!tu)
+        {
+            failures++;
+            return;
+        }
+        try
+        {
+            f(jobs[i], *tu);
+        }
+        catch(const exception&)
+        {
+            failures++;
+        }
+    });
+    return failures;
+}
+
+template<class F>
+std::size_t parallel_parse(const std::vector<parse_job>& jobs, F f, parallel_options opts={})
+{
+    index_pool pool{opts.index_opts};
+    return parallel_parse(jobs, f, pool, opts);
+}
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef LIBCLANGPP_PIPELINE_H
+#define LIBCLANGPP_PIPELINE_H
+
+#include <clangpp/translation_unit.hpp>
+#include <clangpp/index_pool.hpp>
+#include <clangpp/parallel.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace clang {
+
+struct pipeline_options : parallel_options
+{
+    // Extracted results waiting to be consumed. Parsing stops while the
+    // queue is full, so memory stays bounded when consume is the bottleneck.
+    std::size_t queue_size = 64;
+};
+
+namespace detail {
+
+template<class T>
+struct bounded_queue
+{
+    std::size_t capacity;
+    std::mutex m;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<T> items;
+    bool closed = false;
+
+    bounded_queue(std::size_t n) : capacity(n == 0 ? 1 : n)
+    {}
+
+    // Blocks while the queue is full; returns false if it was closed
+    bool push(T x)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        not_full.wait(lock, [&] { return closed || items.size() < capacity; });
+        if (closed) return false;
+        items.push_back(std::move(x));
+        not_empty.notify_one();
+        return true;
+    }
+
+    // Blocks while the queue is empty, then calls f with the next item
+    // outside of the lock; returns false once it is closed and drained
+    template<class F>
+    bool pop(F f)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        not_empty.wait(lock, [&] { return closed || !items.empty(); });
+        if (items.empty()) return false;
+        T x = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        lock.unlock();
+        f(std::move(x));
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        closed = true;
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+};
+
+}
+
+// Parses the jobs on a pool of threads and calls extract(job, tu) on the
+// parsing thread; the translation unit is disposed as soon as extract
+// returns. Its result goes through a bounded queue to consume(job, result),
+// which runs on the calling thread, one result at a time. At most one
+// translation unit per thread and queue_size results are alive at once, no
+// matter how many jobs there are. Returns the number of jobs that failed to
+// parse.
+template<class Extract, class Consume>
+std::size_t pipeline_parse(const std::vector<parse_job>& jobs, Extract extract, Consume consume, index_pool& pool, pipeline_options opts={})
+{
+    using result_type = typename std::decay<decltype(extract(jobs.front(), std::declval<translation_unit&>()))>::type;
+    struct item
+    {
+        std::size_t job;
+        result_type result;
+    };
+    detail::bounded_queue<item> queue{opts.queue_size};
+    std::atomic<std::size_t> failures{0};
+    std::atomic<bool> stop{false};
+    std::exception_ptr error;
+    auto schedule = detail::get_parse_schedule(jobs, opts);
+    std::thread producer([&]
+    {
+        try
+        {
+            detail::parallel_for(jobs.size(), opts.threads, [&](unsigned, std::size_t k)
+            {
+                auto i = schedule[k];
+                if (stop || (opts.cancel != nullptr && *opts.cancel)) return;
+                // The translation unit is released when the lambda returns,
+                // before waiting on the queue
+                auto x = [&]() -> expected<item>
+                {
+                    auto tu = detail::parse_scheduled_job(pool.get(), jobs[i], opts);
+                    if (!tu) return tu.error();
+                    try
+                    {
+                        return item{i, extract(jobs[i], *tu)};
+                    }
+                    catch(const exception&)
+                    {
+                        return CXError_Failure;
+                    }
+                }();
+                if (!x)
+                {
+                    failures++;
+                    return;
+                }
+                if (!queue.push(std::move(*x))) stop = true;
+            });
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+        queue.close();
+    });
+    try
+    {
+        while(queue.pop([&](item x) { consume(jobs[x.job], std::move(x.result)); }));
+    }
+    catch(...)
+    {
+        stop = true;
+        queue.close();
+        producer.join();
+        throw;
+    }
+    producer.join();
+    if (error) std::rethrow_exception(error);
+    return failures;
+}
+
+template<class Extract, class Consume>
+std::size_t pipeline_parse(const std::vector<parse_job>& jobs, Extract extract, Consume consume, pipeline_options opts={})
+{
+    index_pool pool{opts.index_opts};
+    return pipeline_parse(jobs, extract, consume, pool, opts);
+}
+
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef LIBCLANGPP_PROCESS_POOL_H
+#define LIBCLANGPP_PROCESS_POOL_H
+
+#include <clangpp/index.hpp>
+#include <clangpp/index_pool.hpp>
+#include <clangpp/parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace clang {
+
+struct process_options
+{
+    unsigned workers = std::thread::hardware_concurrency();
+    unsigned parse_options = CXTranslationUnit_None;
+    index_options index_opts;
+    // A worker whose resident set grows past this many bytes is replaced
+    // after its current job; zero disables the limit
+    std::size_t memory_limit = 0;
+    // Bytes of shared memory per worker for streaming results to the parent
+    std::size_t ring_size = 1 << 20;
+};
+
+struct process_parse_result
+{
+    // Jobs that failed to parse or extract, that crashed, or that never ran
+    // because no worker could be started for them
+    std::size_t failures = 0;
+    std::size_t restarts = 0;
+    // Jobs that were running when their worker crashed; they are not retried
+    std::vector<std::size_t> crashed;
+};
+
+namespace detail {
+
+const std::uint32_t no_job = 0xffffffff;
+
+// Single producer, single consumer byte stream in shared memory. The worker
+// writes framed messages, the parent reads them, and either side only ever
+// advances its own counter.
+struct shared_ring
+{
+    std::atomic<std::uint64_t> head;
+    std::atomic<std::uint64_t> tail;
+    std::atomic<std::uint32_t> current;
+    std::uint64_t capacity;
+
+    char * data()
+    {
+        return reinterpret_cast<char *>(this + 1);
+    }
+
+    void reset()
+    {
+        head = 0;
+        tail = 0;
+        current = no_job;
+    }
+
+    void write(const char * p, std::size_t n)
+    {
+        while(n > 0)
+        {
+            std::uint64_t h = head.load(std::memory_order_relaxed);
+            std::uint64_t free = capacity - (h - tail.load(std::memory_order_acquire));
+            if (free == 0)
+            {
+                sched_yield();
+                continue;
+            }
+            std::size_t pos = h % capacity;
+            std::size_t count = std::min<std::uint64_t>(std::min<std::uint64_t>(n, free), capacity - pos);
+            std::memcpy(data() + pos, p, count);
+            head.store(h + count, std::memory_order_release);
+            p += count;
+            n -= count;
+        }
+    }
+
+    std::size_t read(std::string& out)
+    {
+        std::uint64_t t = tail.load(std::memory_order_relaxed);
+        std::uint64_t available = head.load(std::memory_order_acquire) - t;
+        std::size_t total = 0;
+        while(available > 0)
+        {
+            std::size_t pos = t % capacity;
+            std::size_t count = std::min<std::uint64_t>(available, capacity - pos);
+            out.append(data() + pos, count);
+            t += count;
+            available -= count;
+            total += count;
+        }
+        tail.store(t, std::memory_order_release);
+        return total;
+    }
+};
+
+struct message_header
+{
+    std::uint32_t job;
+    std::uint32_t ok;
+    std::uint64_t size;
+};
+
+inline std::size_t get_resident_memory()
+{
+    long pages = 0;
+    long resident = 0;
+    FILE * f = std::fopen("/proc/self/statm", "r");
+    if (f == nullptr) return 0;
+    if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    std::fclose(f);
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+template<class Extract>
+void run_worker(const std::vector<parse_job>& jobs, std::atomic<std::uint64_t>& next, shared_ring& ring, Extract& extract, const process_options& opts)
+{
+    auto idx = make_index(opts.index_opts);
+    std::string buffer;
+    for(std::uint64_t i = next++; i < jobs.size(); i = next++)
+    {
+        ring.current = i;
+        message_header h = {std::uint32_t(i), 0, 0};
+        buffer.clear();
+        try
+        {
+            auto tu = try_parse_job_translation_unit(*idx, jobs[i], opts.parse_options);
+            if (tu)
+            {
+                extract(jobs[i], *tu, buffer);
+                h.ok = 1;
+            }
+        }
+        catch(...)
+        {
+            buffer.clear();
+        }
+        h.size = buffer.size();
+        ring.write(reinterpret_cast<const char *>(&h), sizeof(h));
+        ring.write(buffer.data(), buffer.size());
+        ring.current = no_job;
+        if (opts.memory_limit > 0 && get_resident_memory() > opts.memory_limit) break;
+    }
+}
+
+}
+
+// Parses the jobs in forked worker processes, each with its own index, so a
+// crash or runaway allocation in libclang only takes down one worker, which
+// is then replaced. In the worker, extract(job, tu, buffer) serializes
+// whatever is needed from the translation unit into buffer; the bytes are
+// streamed back through shared memory and handed to consume(job, data, size)
+// in the calling process.
+//
+// Call this from a single-threaded process, since it forks.
+template<class Extract, class Consume>
+process_parse_result process_parse(const std::vector<parse_job>& jobs, Extract extract, Consume consume, process_options opts={})
+{
+    process_parse_result result;
+    if (opts.workers == 0) opts.workers = 1;
+    if (opts.workers > jobs.size()) opts.workers = std::max<std::size_t>(jobs.size(), 1);
+    std::size_t ring_bytes = sizeof(detail::shared_ring) + opts.ring_size;
+    ring_bytes = (ring_bytes + 63) / 64 * 64;
+    std::size_t total = 64 + ring_bytes * opts.workers;
+    void * shared = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) throw std::runtime_error("Shared memory can't be mapped");
+    auto * next = new(shared) std::atomic<std::uint64_t>(0);
+    std::vector<detail::shared_ring*> rings;
+    for(unsigned w = 0; w < opts.workers; w++)
+    {
+        auto * ring = new(static_cast<char *>(shared) + 64 + w * ring_bytes) detail::shared_ring();
+        ring->capacity = opts.ring_size;
+        ring->reset();
+        rings.push_back(ring);
+    }
+
+    std::vector<pid_t> pids(opts.workers, -1);
+    std::vector<std::string> pending(opts.workers);
+    auto spawn = [&](unsigned w)
+    {
+        rings[w]->reset();
+        pending[w].clear();
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            detail::run_worker(jobs, *next, *rings[w], extract, opts);
+            _exit(0);
+        }
+        pids[w] = pid;
+        return pid > 0;
+    };
+    auto drain = [&](unsigned w)
+    {
+        if (rings[w]->read(pending[w]) == 0) return false;
+        std::size_t pos = 0;
+        while(pending[w].size() - pos >= sizeof(detail::message_header))
+        {
+            detail::message_header h;
+            std::memcpy(&h, pending[w].data() + pos, sizeof(h));
+            if (pending[w].size() - pos - sizeof(h) < h.size) break;
+            if (h.ok) consume(jobs[h.job], pending[w].data() + pos + sizeof(h), std::size_t(h.size));
+            else result.failures++;
+            pos += sizeof(h) + h.size;
+        }
+        pending[w].erase(0, pos);
+        return true;
+    };
+
+    std::size_t running = 0;
+    for(unsigned w = 0; w < opts.workers; w++)
+    {
+        if (spawn(w)) running++;
+    }
+    if (running == 0)
+    {
+        munmap(shared, total);
+        throw std::runtime_error("Parse workers can't be started");
+    }
+    while(running > 0)
+    {
+        bool progress = false;
+        for(unsigned w = 0; w < opts.workers; w++)
+        {
+            if (pids[w] <= 0) continue;
+            if (drain(w)) progress = true;
+            int status;
+            if (waitpid(pids[w], &status, WNOHANG) != pids[w]) continue;
+            drain(w);
+            pids[w] = -1;
+            running--;
+            progress = true;
+            std::uint32_t job = rings[w]->current;
+            bool crashed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+            if (crashed && job != detail::no_job)
+            {
+                result.crashed.push_back(job);
+                result.failures++;
+            }
+            // A failed fork is usually transient, so it is retried once
+            if (*next < jobs.size() && (spawn(w) || spawn(w)))
+            {
+                result.restarts++;
+                running++;
+            }
+        }
+        if (!progress) usleep(100);
+    }
+    // A worker could not be replaced, so the jobs no one claimed never ran
+    for(auto i = (*next)++; i < jobs.size(); i = (*next)++) result.failures++;
+    munmap(shared, total);
+    return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef LIBCLANGPP_REFERENCES_H
+#define LIBCLANGPP_REFERENCES_H
+
+#include <clangpp/cursor.hpp>
+#include <clangpp/translation_unit.hpp>
+#include <clangpp/parallel.hpp>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+
+// A reference that no longer depends on the translation unit it was found in
+struct reference_location
+{
+    std::string file;
+    unsigned line;
+    unsigned column;
+    unsigned offset;
+    unsigned length;
+    bool is_declaration;
+};
+
+namespace detail {
+
+inline bool is_reference_candidate(CXCursorKind kind)
+{
+    return CLANGPP_CALL(clang_isDeclaration)(kind) || CLANGPP_CALL(clang_isReference)(kind) ||
+        kind == CXCursor_DeclRefExpr || kind == CXCursor_MemberRefExpr || kind == CXCursor_MacroExpansion;
+}
+
+// Remembers which referenced cursors match the usr, so the USR of each
+// declaration is computed once per translation unit instead of once per use
+struct usr_matcher
+{
+    struct entry
+    {
+        cursor decl;
+        bool match;
+        unsigned length;
+    };
+    const char * usr;
+    std::unordered_map<unsigned, std::vector<entry>> cache;
+
+    usr_matcher(const char * u) : usr(u)
+    {}
+
+    const entry& operator()(cursor c)
+    {
+        auto&& bucket = cache[c.hash()];
+        for(auto&& e:bucket)
+        {
+            if (e.decl.equal_cursors(c)) return e;
+        }
+        bool match = std::strcmp(c.get_usr().c_str(), usr) == 0;
+        unsigned length = match ? std::strlen(c.get_spelling().c_str()) : 0;
+        bucket.push_back({c, match, length});
+        return bucket.back();
+    }
+};
+
+}
+
+// Calls f(location) for every reference to, or declaration of, the entity
+// with the given usr in the translation unit. Returning CXVisit_Break from f
+// stops the search.
+template<class F>
+CXVisitorResult find_references_to_usr(translation_unit& tu, string_view usr, F f)
+{
+    detail::usr_matcher match{usr.c_str()};
+    auto result = CXVisit_Continue;
+    tu.get_translation_unit_cursor().visit_children([&](cursor c, cursor)
+    {
+        if (c.get_location().is_in_system_header()) return CXChildVisit_Continue;
+        auto kind = c.get_kind();
+        if (!detail::is_reference_candidate(kind)) return CXChildVisit_Recurse;
+        auto referenced = c.get_referenced();
+        if (referenced.is_null()) return CXChildVisit_Recurse;
+        auto&& e = match(referenced);
+        if (!e.match) return CXChildVisit_Recurse;
+        auto loc = c.get_location().get_spelling_location();
+        if (loc.self == nullptr) return CXChildVisit_Recurse;
+        reference_location r{loc.get_file_name().to_std_string(), loc.line, loc.column, loc.offset, e.length, CLANGPP_CALL(clang_isDeclaration)(kind) != 0};
+        if (f(r) == CXVisit_Break)
+        {
+            result = CXVisit_Break;
+            return CXChildVisit_Break;
+        }
+        return CXChildVisit_Recurse;
+    });
+    return result;
+}
+
+// Searches every job in parallel for references to the usr. Results are
+// streamed to f, under a lock, as soon as each translation unit finds them;
+// references in headers shared by several translation units are reported
+// once. Returning CXVisit_Break from f cancels the remaining search.
+template<class F>
+std::size_t find_references(const std::vector<parse_job>& jobs, string_view usr, F f, parallel_options opts={})
+{
+    std::mutex m;
+    std::set<std::pair<std::string, unsigned>> seen;
+    std::atomic<bool> stop{false};
+    if (opts.cancel == nullptr) opts.cancel = &stop;
+    return parallel_parse(jobs, [&](const parse_job&, translation_unit& tu)
+    {
+        find_references_to_usr(tu, usr, [&](const reference_location& r)
+        {
+            if (*opts.cancel) return CXVisit_Break;
+            std::lock_guard<std::mutex> lock(m);
+            // Another thread may have cancelled while this one waited
+            if (*opts.cancel) return CXVisit_Break;
+            if (!seen.emplace(r.file, r.offset).second) return CXVisit_Continue;
+            if (f(r) == CXVisit_Break) *opts.cancel = true;
+            return *opts.cancel ? CXVisit_Break : CXVisit_Continue;
+        });
+    }, opts);
+}
+
+}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef LIBCLANGPP_SNAPSHOT_H
+#define LIBCLANGPP_SNAPSHOT_H
+
+#include <clangpp/translation_unit.hpp>
+#include <clangpp/snapshot_reader.hpp>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace clang {
+
+struct snapshot_options
+{
+    bool include_system_headers = false;
+};
+
+namespace detail {
+
+struct snapshot_builder
+{
+    std::vector<snapshot_node> nodes;
+    std::vector<snapshot_type> types;
+    std::vector<snapshot_file> files;
+    std::string strings;
+    std::unordered_map<std::string, std::uint32_t> string_ids;
+    // Keyed on the type itself, since distinct types can share a spelling,
+    // such as two local classes with the same name
+    std::unordered_map<type, std::uint32_t> type_ids;
+    std::unordered_map<CXFile, std::uint32_t> file_ids;
+    std::unordered_map<unsigned, std::vector<std::pair<CXCursor, std::uint32_t>>> node_ids;
+    std::vector<CXCursor> referenced;
+
+    snapshot_builder() : strings(1, '\0')
+    {}
+
+    std::uint32_t add_string(const char * s)
+    {
+        if (s == nullptr || *s == '\0') return 0;
+        auto it = string_ids.find(s);
+        if (it != string_ids.end()) return it->second;
+        std::uint32_t offset = strings.size();
+        strings.append(s);
+        strings.push_back('\0');
+        string_ids.emplace(s, offset);
+        return offset;
+    }
+
+    std::uint32_t add_type(type t)
+    {
+        if (t.self.kind == CXType_Invalid) return snapshot_npos;
+        auto it = type_ids.find(t);
+        if (it != type_ids.end()) return it->second;
+        auto spelling = t.get_spelling();
+        std::uint32_t id = types.size();
+        type_ids.emplace(t, id);
+        types.push_back({std::uint32_t(t.self.kind), add_string(spelling.c_str()), id, 0, t.get_size_of(), t.get_align_of()});
+        auto canonical = t.get_canonical_type();
+        if (!canonical.equal_types(t))
+        {
+            auto canonical_id = add_type(canonical);
+            types[id].canonical = canonical_id;
+        }
+        return id;
+    }
+
+    std::uint32_t add_file(CXFile f)
+    {
+        if (f == nullptr) return snapshot_npos;
+        auto it = file_ids.find(f);
+        if (it != file_ids.end()) return it->second;
+        std::uint32_t id = files.size();
+        files.push_back({add_string(file(f).get_file_name().c_str())});
+        file_ids.emplace(f, id);
+        return id;
+    }
+
+    std::uint32_t find_node(cursor c)
+    {
+        auto it = node_ids.find(c.hash());
+        if (it == node_ids.end()) return snapshot_npos;
+        for(auto&& p:it->second)
+        {
+            if (CLANGPP_CALL(clang_equalCursors)(p.first, c.self)) return p.second;
+        }
+        return snapshot_npos;
+    }
+
+    std::uint32_t add_node(cursor c, std::uint32_t parent)
+    {
+        std::uint32_t id = nodes.size();
+        snapshot_node n;
+        n.kind = c.get_kind();
+        n.parent = parent;
+        n.first_child = snapshot_npos;
+        n.next_sibling = snapshot_npos;
+        n.spelling = add_string(c.get_spelling().c_str());
+        n.usr = add_string(c.get_usr().c_str());
+        n.type = add_type(c.get_type());
+        n.referenced = snapshot_npos;
+        n.referenced_usr = 0;
+        auto loc = c.get_location().get_spelling_location();
+        n.file = add_file(loc.self);
+        n.line = loc.line;
+        n.column = loc.column;
+        n.begin_offset = c.get_extent().get_range_start().get_spelling_location().offset;
+        n.end_offset = c.get_extent().get_range_end().get_spelling_location().offset;
+        nodes.push_back(n);
+        node_ids[c.hash()].emplace_back(c.self, id);
+        auto r = c.get_referenced();
+        referenced.push_back(r.self);
+        if (!r.is_null()) nodes[id].referenced_usr = add_string(r.get_usr().c_str());
+        return id;
+    }
+
+    void build(translation_unit& tu, const snapshot_options& opts)
+    {
+        auto root = tu.get_translation_unit_cursor();
+        add_node(root, snapshot_npos);
+        // Explicit stack of (cursor, node id, id of the last child added)
+        struct frame
+        {
+            std::vector<CXCursor> children;
+            std::size_t pos;
+            std::uint32_t id;
+            std::uint32_t last;
+        };
+        std::vector<frame> stack;
+        stack.push_back({get_children(root.self), 0, 0, snapshot_npos});
+        while(!stack.empty())
+        {
+            auto& f = stack.back();
+            if (f.pos == f.children.size())
+            {
+                stack.pop_back();
+                continue;
+            }
+            cursor c = f.children[f.pos++];
+            if (!opts.include_system_headers && c.get_location().is_in_system_header()) continue;
+            auto id = add_node(c, f.id);
+            if (f.last == snapshot_npos) nodes[f.id].first_child = id;
+            else nodes[f.last].next_sibling = id;
+            f.last = id;
+            auto children = get_children(c.self);
+            if (!children.empty()) stack.push_back({std::move(children), 0, id, snapshot_npos});
+        }
+        for(std::size_t i = 0; i < nodes.size(); i++)
+        {
+            if (!CLANGPP_CALL(clang_Cursor_isNull)(referenced[i])) nodes[i].referenced = find_node(referenced[i]);
+        }
+    }
+};
+
+}
+
+// Writes the cursor tree of the translation unit, with the types, extents,
+// spellings and references of each cursor, to a file that can be read back
+// with snapshot_reader.
+inline void write_snapshot(translation_unit& tu, const std::string& path, snapshot_options opts={})
+{
+    detail::snapshot_builder b;
+    b.build(tu, opts);
+    snapshot_header h;
+    init_snapshot_header(h);
+    h.node_count = b.nodes.size();
+    h.type_count = b.types.size();
+    h.file_count = b.files.size();
+    h.string_size = b.strings.size();
+    std::unique_ptr<FILE, int(*)(FILE*)> out(std::fopen(path.c_str(), "wb"), &std::fclose);
+    if (out == nullptr) throw std::runtime_error("Snapshot can't be written: " + path);
+    bool ok = std::fwrite(&h, sizeof(h), 1, out.get()) == 1 &&
+        std::fwrite(b.nodes.data(), sizeof(snapshot_node), b.nodes.size(), out.get()) == b.nodes.size() &&
+        std::fwrite(b.types.data(), sizeof(snapshot_type), b.types.size(), out.get()) == b.types.size() &&
+        std::fwrite(b.files.data(), sizeof(snapshot_file), b.files.size(), out.get()) == b.files.size() &&
+        std::fwrite(b.strings.data(), 1, b.strings.size(), out.get()) == b.strings.size();
+    if (!ok || std::fflush(out.get()) != 0) throw std::runtime_error("Snapshot can't be written: " + path);
+}
+
+}
+
+#endif
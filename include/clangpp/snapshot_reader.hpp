@@ -0,0 +1,199 @@
+#ifndef LIBCLANGPP_SNAPSHOT_READER_H
+#define LIBCLANGPP_SNAPSHOT_READER_H
+
+// This header does not depend on libclang, so snapshots can be read on
+// machines where it is not installed.
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clang {
+
+// Layout of a snapshot file, all in native byte order:
+//
+//     snapshot_header
+//     snapshot_node[node_count]     in pre-order, node 0 is the translation unit
+//     snapshot_type[type_count]
+//     snapshot_file[file_count]
+//     char[string_size]             null-terminated strings, offset 0 is ""
+//
+// Kinds are the raw values of CXCursorKind and CXTypeKind.
+const std::uint32_t snapshot_version = 1;
+const std::uint32_t snapshot_npos = 0xffffffff;
+
+struct snapshot_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t node_count;
+    std::uint32_t type_count;
+    std::uint32_t file_count;
+    std::uint64_t string_size;
+};
+
+struct snapshot_node
+{
+    std::uint32_t kind;
+    std::uint32_t parent;
+    std::uint32_t first_child;
+    std::uint32_t next_sibling;
+    std::uint32_t spelling;
+    std::uint32_t usr;
+    std::uint32_t type;
+    // Node index of the referenced declaration, or snapshot_npos when it is
+    // not part of the snapshot; its usr is always recorded
+    std::uint32_t referenced;
+    std::uint32_t referenced_usr;
+    std::uint32_t file;
+    std::uint32_t line;
+    std::uint32_t column;
+    std::uint32_t begin_offset;
+    std::uint32_t end_offset;
+};
+
+struct snapshot_type
+{
+    std::uint32_t kind;
+    std::uint32_t spelling;
+    std::uint32_t canonical;
+    std::uint32_t reserved;
+    std::int64_t size;
+    std::int64_t align;
+};
+
+struct snapshot_file
+{
+    std::uint32_t name;
+};
+
+inline void init_snapshot_header(snapshot_header& h)
+{
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, "CLPPSNAP", 8);
+    h.version = snapshot_version;
+}
+
+struct snapshot_reader
+{
+    const char * data;
+    std::size_t size;
+    const snapshot_header * header;
+
+    snapshot_reader(const std::string& path) : data(nullptr), size(0), header(nullptr)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Snapshot can't be opened: " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(snapshot_header))
+        {
+            ::close(fd);
+            throw std::runtime_error("Snapshot is truncated: " + path);
+        }
+        size = st.st_size;
+        void * p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) throw std::runtime_error("Snapshot can't be mapped: " + path);
+        data = static_cast<const char *>(p);
+        header = reinterpret_cast<const snapshot_header *>(data);
+        if (std::memcmp(header->magic, "CLPPSNAP", 8) != 0 || header->version != snapshot_version)
+        {
+            unmap();
+            throw std::runtime_error("Not a snapshot of version " + std::to_string(snapshot_version) + ": " + path);
+        }
+        if (strings_offset() + header->string_size > size)
+        {
+            unmap();
+            throw std::runtime_error("Snapshot is truncated: " + path);
+        }
+    }
+
+    snapshot_reader(const snapshot_reader&)=delete;
+    snapshot_reader& operator=(const snapshot_reader&)=delete;
+
+    ~snapshot_reader()
+    {
+        unmap();
+    }
+
+    std::uint32_t node_count() const
+    {
+        return header->node_count;
+    }
+
+    std::uint32_t type_count() const
+    {
+        return header->type_count;
+    }
+
+    std::uint32_t file_count() const
+    {
+        return header->file_count;
+    }
+
+    const snapshot_node& node(std::uint32_t i) const
+    {
+        return nodes()[i];
+    }
+
+    const snapshot_type& type(std::uint32_t i) const
+    {
+        return types()[i];
+    }
+
+    const snapshot_file& file(std::uint32_t i) const
+    {
+        return files()[i];
+    }
+
+    const char * string(std::uint32_t offset) const
+    {
+        return data + strings_offset() + offset;
+    }
+
+    const snapshot_node * nodes() const
+    {
+        return reinterpret_cast<const snapshot_node *>(data + sizeof(snapshot_header));
+    }
+
+    const snapshot_type * types() const
+    {
+        return reinterpret_cast<const snapshot_type *>(nodes() + header->node_count);
+    }
+
+    const snapshot_file * files() const
+    {
+        return reinterpret_cast<const snapshot_file *>(types() + header->type_count);
+    }
+
+    // Calls f(index, node) for each child of the node
+    template<class F>
+    void for_each_child(std::uint32_t parent, F f) const
+    {
+        for(auto i = node(parent).first_child; i != snapshot_npos; i = node(i).next_sibling) f(i, node(i));
+    }
+
+private:
+    std::size_t strings_offset() const
+    {
+        return sizeof(snapshot_header) +
+            std::size_t(header->node_count) * sizeof(snapshot_node) +
+            std::size_t(header->type_count) * sizeof(snapshot_type) +
+            std::size_t(header->file_count) * sizeof(snapshot_file);
+    }
+
+    void unmap()
+    {
+        if (data != nullptr) ::munmap(const_cast<char *>(data), size);
+        data = nullptr;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef LIBCLANGPP_STRING_H
+#define LIBCLANGPP_STRING_H
+
+#include <clangpp/detail.hpp>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <clang-c/CXErrorCode.h>
+#include <clang-c/CXString.h>
+
+namespace clang {
+
+struct exception : std::runtime_error
+{
+    static const char * get_error_name(CXErrorCode e) noexcept
+    {
+        switch(e)
+        {
+            case CXError_ASTReadError: return "AST Read Error";
+            case CXError_Crashed: return "Crashed";
+            case CXError_Failure: return "Failure";
+            case CXError_InvalidArguments: return "Invalid Arguments";
+            case CXError_Success: return "Success";
+        }
+        return "Unknown Error";
+    }
+
+    static std::string as_string(CXErrorCode e)
+    {
+        return get_error_name(e);
+    }
+
+    exception(CXErrorCode e) : std::runtime_error(as_string(e))
+    {}
+
+    exception(CXErrorCode e, std::string message) : std::runtime_error(message + ": " + as_string(e))
+    {}
+};
+
+#define CLANGPP_THROW_ERROR(e) throw clang::exception(e, __PRETTY_FUNCTION__)
+
+// Either a value or the error code that prevented it. Nothing is allocated
+// or thrown on failure unless value() is called.
+template<class T>
+struct expected
+{
+    expected(T v) : code(CXError_Success), x(std::move(v))
+    {}
+    expected(CXErrorCode e) noexcept : code(e == CXError_Success ? CXError_Failure : e)
+    {}
+    expected(expected&& rhs) noexcept(std::is_nothrow_move_constructible<T>{}) : code(rhs.code)
+    {
+        if (rhs.has_value()) new(&x) T(std::move(rhs.x));
+    }
+    expected(const expected& rhs) : code(rhs.code)
+    {
+        if (rhs.has_value()) new(&x) T(rhs.x);
+    }
+    expected& operator=(expected rhs)
+    {
+        if (this->has_value()) x.~T();
+        code = rhs.code;
+        if (rhs.has_value()) new(&x) T(std::move(rhs.x));
+        return *this;
+    }
+    ~expected()
+    {
+        if (this->has_value()) x.~T();
+    }
+
+    bool has_value() const noexcept
+    {
+        return code == CXError_Success;
+    }
+    explicit operator bool() const noexcept
+    {
+        return this->has_value();
+    }
+    CXErrorCode error() const noexcept
+    {
+        return code;
+    }
+
+    T& value()
+    {
+        if (!this->has_value()) CLANGPP_THROW_ERROR(code);
+        return x;
+    }
+    T& operator*()
+    {
+        return x;
+    }
+    T* operator->()
+    {
+        return &x;
+    }
+private:
+    CXErrorCode code;
+    union { T x; };
+};
+
+struct string
+{
+    CXString self;
+    string()
+    {}
+    string(CXString s) : self(s)
+    {}
+    string(string&& rhs) : self(rhs.self)
+    {
+        rhs.self.data = nullptr;
+    }
+    string& operator=(string rhs)
+    {
+        std::swap(rhs.self, this->self);
+        return *this;
+    }
+    string& operator=(CXString rhs)
+    {
+        std::swap(rhs, this->self);
+        return *this;
+    }
+    string(const string&)=delete;
+    ~string()
+    {
+        if (self.data != nullptr) CLANGPP_CALL(clang_disposeString)(self);
+    }
+    const char * c_str() const
+    {
+        return CLANGPP_CALL(clang_getCString)(self);
+    }
+
+    std::string to_std_string() const
+    {
+        return this->c_str();
+    }
+};
+
+class string_view
+{
+    const char * s;
+public:
+    string_view() : s(nullptr)
+    {}
+    string_view(const char * s) : s(s)
+    {}
+
+    string_view(const std::string& s) : s(s.c_str())
+    {}
+
+    string_view(const string& s) : s(s.c_str())
+    {}
+
+    const char * c_str() const
+    {
+        return s;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef LIBCLANGPP_TRACE_H
+#define LIBCLANGPP_TRACE_H
+
+// Timing of libclang calls. Defining CLANGPP_TRACE before including
+// clangpp.hpp routes every libclang call made by the wrappers through
+// detail::traced_call; without it the wrappers call libclang directly and
+// none of this is compiled in.
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef CLANGPP_TRACE_MAX_EVENTS
+// Events kept per thread for the trace file; counters are always updated
+#define CLANGPP_TRACE_MAX_EVENTS (1 << 20)
+#endif
+
+namespace clang {
+
+namespace trace {
+
+struct event
+{
+    const char * name;
+    std::uint64_t start;
+    std::uint64_t duration;
+};
+
+struct counter
+{
+    std::uint64_t calls = 0;
+    std::uint64_t total = 0;
+    std::uint64_t max = 0;
+};
+
+}
+
+namespace detail {
+
+struct trace_buffer
+{
+    std::uint32_t tid;
+    std::mutex m;
+    std::vector<trace::event> events;
+    std::map<const char *, trace::counter> counters;
+};
+
+struct trace_registry
+{
+    std::mutex m;
+    std::vector<std::shared_ptr<trace_buffer>> buffers;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    static trace_registry& get()
+    {
+        static trace_registry r;
+        return r;
+    }
+
+    std::uint64_t now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+};
+
+// Buffers outlive their threads, so calls made by finished worker threads
+// still show up in the report
+inline trace_buffer& get_trace_buffer()
+{
+    thread_local std::shared_ptr<trace_buffer> buffer = []
+    {
+        auto&& r = trace_registry::get();
+        auto b = std::make_shared<trace_buffer>();
+        std::lock_guard<std::mutex> lock(r.m);
+        b->tid = r.buffers.size();
+        r.buffers.push_back(b);
+        return b;
+    }();
+    return *buffer;
+}
+
+struct trace_scope
+{
+    const char * name;
+    std::uint64_t start;
+
+    trace_scope(const char * n) : name(n), start(trace_registry::get().now())
+    {}
+
+    trace_scope(const trace_scope&)=delete;
+    trace_scope& operator=(const trace_scope&)=delete;
+
+    ~trace_scope()
+    {
+        auto duration = trace_registry::get().now() - start;
+        auto&& b = get_trace_buffer();
+        std::lock_guard<std::mutex> lock(b.m);
+        auto&& c = b.counters[name];
+        c.calls++;
+        c.total += duration;
+        if (duration > c.max) c.max = duration;
+        if (b.events.size() < CLANGPP_TRACE_MAX_EVENTS) b.events.push_back({name, start, duration});
+    }
+};
+
+template<class F, F f>
+struct traced_call
+{
+    const char * name;
+
+    template<class... Ts>
+    auto operator()(Ts&&... xs) const -> decltype(f(std::forward<Ts>(xs)...))
+    {
+        trace_scope scope(name);
+        return f(std::forward<Ts>(xs)...);
+    }
+};
+
+// Microseconds with nanosecond precision, without going through floating point
+inline void write_micros(std::ostream& os, std::uint64_t ns)
+{
+    char fraction[4] = { char('0' + ns / 100 % 10), char('0' + ns / 10 % 10), char('0' + ns % 10), '\0' };
+    os << ns / 1000 << '.' << fraction;
+}
+
+inline void write_json_name(std::ostream& os, const char * name)
+{
+    // Names are libclang function names, which never need escaping
+    os << '"' << name << '"';
+}
+
+}
+
+namespace trace {
+
+// Per-function counters merged across all threads
+inline std::map<std::string, counter> get_counters()
+{
+    std::map<std::string, counter> result;
+    auto&& r = detail::trace_registry::get();
+    std::lock_guard<std::mutex> lock(r.m);
+    for(auto&& b:r.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(b->m);
+        for(auto&& p:b->counters)
+        {
+            auto&& c = result[p.first];
+            c.calls += p.second.calls;
+            c.total += p.second.total;
+            if (p.second.max > c.max) c.max = p.second.max;
+        }
+    }
+    return result;
+}
+
+// Writes every recorded call in the Chrome trace event format, which can be
+// loaded in chrome://tracing or Perfetto
+inline void write_chrome_trace(std::ostream& os)
+{
+    auto&& r = detail::trace_registry::get();
+    std::lock_guard<std::mutex> lock(r.m);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for(auto&& b:r.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(b->m);
+        for(auto&& e:b->events)
+        {
+            if (!first) os << ",\n";
+            os << "{\"name\":";
+            detail::write_json_name(os, e.name);
+            os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << b->tid << ",\"ts\":";
+            detail::write_micros(os, e.start);
+            os << ",\"dur\":";
+            detail::write_micros(os, e.duration);
+            os << '}';
+            first = false;
+        }
+    }
+    os << "]}\n";
+}
+
+// Writes the counters as a JSON object keyed by function name, with times in
+// nanoseconds
+inline void write_counters(std::ostream& os)
+{
+    os << '{';
+    bool first = true;
+    for(auto&& p:get_counters())
+    {
+        if (!first) os << ",\n";
+        detail::write_json_name(os, p.first.c_str());
+        os << ":{\"calls\":" << p.second.calls << ",\"total_ns\":" << p.second.total << ",\"max_ns\":" << p.second.max << '}';
+        first = false;
+    }
+    os << "}\n";
+}
+
+inline void reset()
+{
+    auto&& r = detail::trace_registry::get();
+    std::lock_guard<std::mutex> lock(r.m);
+    for(auto&& b:r.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(b->m);
+        b->events.clear();
+        b->counters.clear();
+    }
+}
+
+}
+
+}
+
+#endif
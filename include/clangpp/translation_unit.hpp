@@ -0,0 +1,189 @@
+#ifndef LIBCLANGPP_TRANSLATION_UNIT_H
+#define LIBCLANGPP_TRANSLATION_UNIT_H
+
+#include <clangpp/completion.hpp>
+#include <clangpp/cursor.hpp>
+#include <clangpp/diagnostic.hpp>
+#include <clang-c/Index.h>
+
+namespace clang {
+
+struct index_action;
+
+struct translation_unit
+{
+    detail::shared_ptr<CXTranslationUnit> self;
+
+    translation_unit(CXTranslationUnit tu) : self(tu, &clang_disposeTranslationUnit)
+    {}
+
+    static translation_unit from_cursor(cursor c)
+    {
+        return CLANGPP_CALL(clang_Cursor_getTranslationUnit)(c.self);
+    }
+
+    bool is_file_multiple_include_guarded(file file)
+    {
+        return CLANGPP_CALL(clang_isFileMultipleIncludeGuarded)(self.get(), file.self);
+    }
+    file get_file(string_view file_name)
+    {
+        return CLANGPP_CALL(clang_getFile)(self.get(), file_name.c_str());
+    }
+    source_location get_location(file file, unsigned line, unsigned column)
+    {
+        return CLANGPP_CALL(clang_getLocation)(self.get(), file.self, line, column);
+    }
+    source_location get_location_for_offset(file file, unsigned offset)
+    {
+        return CLANGPP_CALL(clang_getLocationForOffset)(self.get(), file.self, offset);
+    }
+    CXSourceRangeList* get_skipped_ranges(file file)
+    {
+        return CLANGPP_CALL(clang_getSkippedRanges)(self.get(), file.self);
+    }
+    auto get_diagnostic()
+    {
+        return detail::make_index_range(0, CLANGPP_CALL(clang_getNumDiagnostics)(self.get()), [this](unsigned i) 
+        {
+            return diagnostic_set::diagnostic(CLANGPP_CALL(clang_getDiagnostic)(self.get(), i));
+        });
+    }
+    diagnostic_set get_diagnostic_set()
+    {
+        return CLANGPP_CALL(clang_getDiagnosticSetFromTU)(self.get());
+    }
+    string get_translation_unit_spelling()
+    {
+        return CLANGPP_CALL(clang_getTranslationUnitSpelling)(self.get());
+    }
+    unsigned default_save_options()
+    {
+        return CLANGPP_CALL(clang_defaultSaveOptions)(self.get());
+    }
+    int save_translation_unit(string_view file_name, unsigned options)
+    {
+        return CLANGPP_CALL(clang_saveTranslationUnit)(self.get(), file_name.c_str(), options);
+    }
+    unsigned default_reparse_options()
+    {
+        return CLANGPP_CALL(clang_defaultReparseOptions)(self.get());
+    }
+    int reparse_translation_unit(unsigned num_unsaved_files, CXUnsavedFile * unsaved_files, unsigned options)
+    {
+        return CLANGPP_CALL(clang_reparseTranslationUnit)(self.get(), num_unsaved_files, unsaved_files, options);
+    }
+    // tu_resource_usage get_cxtu_resource_usage()
+    // {
+    //     return clang_getCXTUResourceUsage(self);
+    // }
+    unsigned long get_memory_usage()
+    {
+        CXTUResourceUsage usage = CLANGPP_CALL(clang_getCXTUResourceUsage)(self.get());
+        unsigned long result = 0;
+        for(unsigned i = 0; i < usage.numEntries; i++) result += usage.entries[i].amount;
+        CLANGPP_CALL(clang_disposeCXTUResourceUsage)(usage);
+        return result;
+    }
+    cursor get_translation_unit_cursor()
+    {
+        return CLANGPP_CALL(clang_getTranslationUnitCursor)(self.get());
+    }
+    cursor get_cursor(source_location source_location_var)
+    {
+        return CLANGPP_CALL(clang_getCursor)(self.get(), source_location_var.self);
+    }
+    module get_module_for_file(file file_var)
+    {
+        return CLANGPP_CALL(clang_getModuleForFile)(self.get(), file_var.self);
+    }
+    unsigned get_num_top_level_headers(module module)
+    {
+        return CLANGPP_CALL(clang_Module_getNumTopLevelHeaders)(self.get(), module.self);
+    }
+    file get_top_level_header(module module, unsigned index)
+    {
+        return CLANGPP_CALL(clang_Module_getTopLevelHeader)(self.get(), module.self, index);
+    }
+    struct token_array_handler
+    {
+        CXToken * tokens;
+        unsigned size;
+        detail::shared_ptr<CXTranslationUnit> tu;
+        token_array_handler(CXToken * ptokens, unsigned psize, detail::shared_ptr<CXTranslationUnit> ptu)
+        : tokens(ptokens), size(psize), tu(ptu)
+        {}
+        ~token_array_handler()
+        {
+            CLANGPP_CALL(clang_disposeTokens)(tu.get(), tokens, size);
+        }
+    };
+    struct token
+    {
+        CXToken self;
+        detail::shared_ptr<CXTranslationUnit> tu;
+
+        string get_spelling()
+        {
+            return CLANGPP_CALL(clang_getTokenSpelling)(tu.get(), self);
+        }
+        source_location get_location()
+        {
+            return CLANGPP_CALL(clang_getTokenLocation)(tu.get(), self);
+        }
+        source_range get_extent()
+        {
+            return CLANGPP_CALL(clang_getTokenExtent)(tu.get(), self);
+        }
+        CXTokenKind get_kind()
+        {
+            return CLANGPP_CALL(clang_getTokenKind)(self);
+        }
+    };
+    auto tokenize(source_range range)
+    {
+        CXToken * start;
+        unsigned size;
+        CLANGPP_CALL(clang_tokenize)(self.get(), range.self, &start, &size);
+        auto ta = std::make_shared<token_array_handler>(start, size, this->self);
+        return detail::make_iota_range(start, start+size, [ta](CXToken * t)
+        {
+            return token{*t, ta->tu};
+        });
+    }
+    void annotate_tokens(CXToken * tokens, unsigned num_tokens, CXCursor * cursors)
+    {
+        CLANGPP_CALL(clang_annotateTokens)(self.get(), tokens, num_tokens, cursors);
+    }
+    void dispose_tokens(CXToken * tokens, unsigned num_tokens)
+    {
+        CLANGPP_CALL(clang_disposeTokens)(self.get(), tokens, num_tokens);
+    }
+    code_complete_results code_complete_at(const char * complete_filename, unsigned complete_line, unsigned complete_column, CXUnsavedFile * unsaved_files, unsigned num_unsaved_files, unsigned options)
+    {
+        return CLANGPP_CALL(clang_codeCompleteAt)(self.get(), complete_filename, complete_line, complete_column, unsaved_files, num_unsaved_files, options);
+    }
+    void get_inclusions(CXInclusionVisitor visitor, CXClientData client_data)
+    {
+        CLANGPP_CALL(clang_getInclusions)(self.get(), visitor, client_data);
+    }
+    template<class F>
+    CXResult find_includes_in_file(file file, F f)
+    {
+        return CLANGPP_CALL(clang_findIncludesInFile)(self.get(), file.self, cursor::make_range_visitor(f));
+    }
+#ifdef __has_feature
+#  if __has_feature(blocks)
+    CXResult find_includes_in_file_with_block(file file_var, CXCursorAndRangeVisitorBlock cursor_and_range_visitor_block_var)
+    {
+        return CLANGPP_CALL(clang_findIncludesInFileWithBlock)(self, file_var, cursor_and_range_visitor_block_var);
+    }
+#endif
+#endif
+};
+
+using token = translation_unit::token;
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef LIBCLANGPP_TYPE_INTERNER_H
+#define LIBCLANGPP_TYPE_INTERNER_H
+
+#include <clangpp/cursor.hpp>
+#include <clangpp/translation_unit.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+
+const std::uint32_t type_interner_npos = std::uint32_t(-1);
+
+// Maps the canonical types of a translation unit to dense ids, and caches
+// the spelling and layout of each, so tables and statistics keyed by type
+// only cross into libclang the first time a type is seen. Types that
+// differ only by sugar, such as a typedef and its target, get the same id.
+struct type_interner
+{
+    struct entry
+    {
+        type canonical;
+        CXTypeKind kind;
+        std::uint32_t spelling;
+        long long size;
+        long long align;
+    };
+
+    // Holds the translation unit so the interned types stay valid
+    type_interner(translation_unit& unit) : tu(unit.self), strings(1, '\0')
+    {}
+
+    type_interner(const type_interner&)=delete;
+    type_interner& operator=(const type_interner&)=delete;
+
+    // Returns the id of the canonical type of t, or type_interner_npos for an
+    // invalid type
+    std::uint32_t intern(type t)
+    {
+        if (t.self.kind == CXType_Invalid) return type_interner_npos;
+        auto it = seen.find(t);
+        if (it != seen.end()) return it->second;
+        auto canonical = t.get_canonical_type();
+        auto id = intern_canonical(canonical);
+        seen.emplace(t, id);
+        return id;
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+    const entry& get(std::uint32_t id) const
+    {
+        return entries[id];
+    }
+
+    type get_type(std::uint32_t id) const
+    {
+        return entries[id].canonical;
+    }
+
+    const char * get_spelling(std::uint32_t id) const
+    {
+        return strings.c_str() + entries[id].spelling;
+    }
+
+    long long get_size_of(std::uint32_t id) const
+    {
+        return entries[id].size;
+    }
+
+    long long get_align_of(std::uint32_t id) const
+    {
+        return entries[id].align;
+    }
+
+private:
+    detail::shared_ptr<CXTranslationUnit> tu;
+    std::vector<entry> entries;
+    std::string strings;
+    // Every type seen, sugared or not, mapped to the id of its canonical type
+    std::unordered_map<type, std::uint32_t> seen;
+
+    std::uint32_t intern_canonical(type canonical)
+    {
+        auto it = seen.find(canonical);
+        if (it != seen.end()) return it->second;
+        std::uint32_t id = entries.size();
+        std::uint32_t spelling = strings.size();
+        strings.append(canonical.get_spelling().c_str());
+        strings.push_back('\0');
+        entries.push_back({canonical, canonical.self.kind, spelling, canonical.get_size_of(), canonical.get_align_of()});
+        seen.emplace(canonical, id);
+        return id;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+#include <clangpp/ast_visitor.hpp>
+#include <clangpp/index.hpp>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+struct call_counter : clang::ast_visitor<call_counter>
+{
+    std::vector<std::string> functions;
+    std::size_t calls = 0;
+
+    void on_function_decl(clang::cursor c)
+    {
+        functions.push_back(c.get_spelling().to_std_string());
+    }
+
+    void on_call_expr(clang::cursor)
+    {
+        calls++;
+    }
+};
+
+struct template_counter : clang::ast_visitor<template_counter>
+{
+    void on_class_template(clang::cursor)
+    {}
+};
+
+// Skips function bodies, so local declarations are not counted
+struct function_counter : clang::ast_visitor<function_counter>
+{
+    std::size_t functions = 0;
+
+    static constexpr bool visits_code()
+    {
+        return false;
+    }
+
+    CXChildVisitResult on_function_decl(clang::cursor)
+    {
+        functions++;
+        return CXChildVisit_Continue;
+    }
+};
+
+static_assert(call_counter::overrides_call_expr(), "");
+static_assert(!call_counter::overrides_var_decl(), "");
+static_assert(call_counter::visits_code(), "");
+static_assert(!template_counter::visits_code(), "");
+static_assert(template_counter::visits_declarations(), "");
+static_assert(!function_counter::visits_code(), "");
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(dir + "call_graph_example.cpp");
+
+    call_counter calls;
+    calls.visit(tu.get_translation_unit_cursor());
+    CHECK((calls.functions == std::vector<std::string>{"leaf", "middle", "top", "unused"}));
+    CHECK(calls.calls == 4);
+
+    function_counter functions;
+    functions.visit(tu.get_translation_unit_cursor());
+    CHECK(functions.functions == 4);
+}
@@ -33,6 +33,60 @@ int main() {
     CHECK(classes[0] == "foo");
     CHECK(methods[0] == "method()");
 
+    auto decls_tu = idx.parse_translation_unit(dir + "example.cpp", clang::parse_profile::declarations_only);
+    CHECK(decls_tu.get_memory_usage() > 0);
+    int decls = 0;
+    decls_tu.get_translation_unit_cursor().visit_children([&](clang::cursor c, clang::cursor)
+    {
+        if (c.get_kind() == CXCursor_StructDecl) decls++;
+        return CXChildVisit_Continue;
+    });
+    CHECK(decls == 1);
+
+    auto parsed = idx.try_parse_translation_unit(dir + "example.cpp", nullptr, 0, nullptr, 0, CXTranslationUnit_None);
+    CHECK(parsed.has_value());
+    CHECK(parsed.error() == CXError_Success);
+    CHECK(parsed->get_translation_unit_cursor().get_kind() == CXCursor_TranslationUnit);
+    // Unsaved files are counted but missing
+    auto invalid = idx.try_parse_translation_unit(dir + "example.cpp", nullptr, 0, nullptr, 1, CXTranslationUnit_None);
+    CHECK(!invalid);
+    CHECK(invalid.error() == CXError_InvalidArguments);
+    bool thrown = false;
+    try
+    {
+        invalid.value();
+    }
+    catch(const clang::exception&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(clang::exception::as_string(CXErrorCode(-1)) == "Unknown Error");
+
+    auto root = tu.get_translation_unit_cursor();
+    auto descendants = root.descendants();
+    auto method = std::find_if(descendants.begin(), descendants.end(), [](clang::cursor c)
+    {
+        return c.get_kind() == CXCursor_CXXMethod;
+    });
+    CHECK(method != descendants.end());
+    CHECK((*method).get_spelling().to_std_string() == "method");
+    auto children = root.children();
+    CHECK(std::any_of(children.begin(), children.end(), [](clang::cursor c)
+    {
+        return c.get_kind() == CXCursor_StructDecl;
+    }));
+
+    // it++ gives the cursor from before the increment
+    auto first_descendant = descendants.begin();
+    auto first = *first_descendant;
+    CHECK((*first_descendant++).equal_cursors(first));
+    CHECK(!(*first_descendant).equal_cursors(first));
+    auto first_child = children.begin();
+    first = *first_child;
+    CHECK((*first_child++).equal_cursors(first));
+    CHECK(first_child == children.end() || !(*first_child).equal_cursors(first));
+
     auto f = tu.get_file(dir + "example.cpp");
     auto start = tu.get_location(f, 1, 1);
     auto stop = tu.get_location(f, 7, 1);
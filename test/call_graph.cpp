@@ -0,0 +1,53 @@
+#include <clangpp/call_graph.hpp>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(dir + "call_graph_example.cpp");
+    auto g = clang::build_call_graph(tu);
+    CHECK(g.node_count() == 4);
+    // leaf is called twice from middle, but there is one edge
+    CHECK(g.edge_count() == 3);
+
+    auto leaf = g.find("c:@F@leaf#I#");
+    auto middle = g.find("c:@F@middle#I#");
+    auto top = g.find("c:@F@top#");
+    auto unused = g.find("c:@F@unused#");
+    CHECK(leaf != clang::call_graph_npos);
+    CHECK(middle != clang::call_graph_npos);
+    CHECK(top != clang::call_graph_npos);
+    CHECK(unused != clang::call_graph_npos);
+    CHECK(g.find("c:@F@missing#") == clang::call_graph_npos);
+    CHECK(std::string(g.get_usr(top)) == "c:@F@top#");
+
+    std::vector<std::uint32_t> callees;
+    for(auto n:g.get_callees(middle)) callees.push_back(n);
+    CHECK(callees == std::vector<std::uint32_t>{leaf});
+
+    auto reachable = g.get_reachable({top});
+    CHECK(reachable[top]);
+    CHECK(reachable[middle]);
+    CHECK(reachable[leaf]);
+    CHECK(!reachable[unused]);
+
+    auto callers = g.transpose();
+    CHECK(callers.edge_count() == g.edge_count());
+    std::size_t leaf_callers = 0;
+    for(auto n:callers.get_callees(leaf))
+    {
+        CHECK(n == middle || n == unused);
+        leaf_callers++;
+    }
+    CHECK(leaf_callers == 2);
+
+    clang::parse_job job{dir, dir + "call_graph_example.cpp", {"clang", dir + "call_graph_example.cpp"}};
+    auto parallel = clang::build_call_graph(std::vector<clang::parse_job>{job, job});
+    CHECK(parallel.node_count() == g.node_count());
+    CHECK(parallel.edge_count() == g.edge_count());
+}
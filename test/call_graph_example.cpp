@@ -0,0 +1,19 @@
+int leaf(int x)
+{
+    return x + 1;
+}
+
+int middle(int x)
+{
+    return leaf(x) + leaf(x + 1);
+}
+
+int top()
+{
+    return middle(1);
+}
+
+int unused()
+{
+    return leaf(2);
+}
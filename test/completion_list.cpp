@@ -0,0 +1,76 @@
+#include <clangpp.hpp>
+#include <clangpp/completion_list.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string name = "completion.cpp";
+    std::string contents = "struct foo { int alpha; void beta(int x, int y = 0); };\nvoid f() { foo x; x. }\n";
+    CXUnsavedFile unsaved;
+    unsaved.Filename = name.c_str();
+    unsaved.Contents = contents.c_str();
+    unsaved.Length = contents.size();
+
+    clang::index idx{};
+    auto tu = idx.parse_translation_unit(name, {}, {unsaved});
+    auto results = tu.code_complete_at(name.c_str(), 2, 21, &unsaved, 1, clang_defaultCodeCompleteOptions());
+    CHECK(results.size() > 0);
+
+    clang::completion_list list{results};
+    CHECK(list.size() == results.size());
+
+    bool found_alpha = false;
+    bool found_beta = false;
+    std::size_t i = 0;
+    for(auto&& r:results)
+    {
+        auto&& record = list.records[i++];
+        clang::completion_string s{r.CompletionString};
+        CHECK(record.cursor_kind == r.CursorKind);
+        CHECK(record.priority == s.get_completion_priority());
+        CHECK(record.num_annotations == s.get_completion_num_annotations());
+
+        // The top-level chunks match the chunk by chunk API
+        std::uint32_t c = record.first_chunk;
+        for(unsigned k = 0; k < s.get_num_completion_chunks(); k++)
+        {
+            auto&& chunk = list.chunks[c];
+            CHECK(chunk.kind == s.get_completion_chunk_kind(k));
+            auto text = s.get_completion_chunk_text(k);
+            CHECK(std::strcmp(list.get_text(chunk.text), text.c_str() == nullptr ? "" : text.c_str()) == 0);
+            c += 1 + chunk.nested;
+        }
+        CHECK(c == record.first_chunk + record.num_chunks);
+
+        std::string typed = list.get_text(record.typed_text);
+        if (typed == "alpha")
+        {
+            found_alpha = true;
+            CHECK(record.cursor_kind == CXCursor_FieldDecl);
+        }
+        if (typed == "beta")
+        {
+            found_beta = true;
+            CHECK(record.cursor_kind == CXCursor_CXXMethod);
+            // The default argument is in an optional chunk
+            bool optional = false;
+            for(auto k = record.first_chunk; k < record.first_chunk + record.num_chunks; k++)
+            {
+                if (list.chunks[k].kind == CXCompletionChunk_Optional)
+                {
+                    optional = true;
+                    CHECK(list.chunks[k].nested > 0);
+                }
+            }
+            CHECK(optional);
+        }
+    }
+    CHECK(found_alpha);
+    CHECK(found_beta);
+
+    // Text shared by many results, such as "(" and "int", is stored once
+    CHECK(list.strings.entries.size() < list.chunks.size());
+}
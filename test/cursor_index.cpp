@@ -0,0 +1,67 @@
+#include <clangpp.hpp>
+#include <clangpp/cursor_index.hpp>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+    std::string filename = dir + "call_graph_example.cpp";
+
+    clang::index idx{};
+    auto tu = idx.parse_translation_unit(filename);
+    auto f = tu.get_file(filename);
+    auto get_offset = [&](unsigned line, unsigned column)
+    {
+        return tu.get_location(f, line, column).get_file_location().offset;
+    };
+    // The name of leaf, the x in its body, the callee in middle, a blank
+    // line and the parameter of leaf
+    std::vector<unsigned> offsets = {get_offset(1, 5), get_offset(3, 12), get_offset(8, 12), get_offset(5, 1), get_offset(1, 10)};
+    std::vector<clang::cursor_position> positions;
+    for(auto offset:offsets) positions.push_back({f.self, offset});
+
+    auto cursors = clang::get_cursors(tu, positions);
+    CHECK(cursors.size() == 5);
+    CHECK(cursors[0].get_kind() == CXCursor_FunctionDecl);
+    CHECK(cursors[0].get_spelling().to_std_string() == "leaf");
+    CHECK(cursors[1].get_kind() == CXCursor_DeclRefExpr);
+    CHECK(cursors[1].get_spelling().to_std_string() == "x");
+    CHECK(cursors[2].get_kind() == CXCursor_DeclRefExpr);
+    CHECK(cursors[2].get_spelling().to_std_string() == "leaf");
+    CHECK(cursors[3].is_null());
+    CHECK(cursors[4].get_kind() == CXCursor_ParmDecl);
+
+    // The order of the positions does not matter
+    std::vector<clang::cursor_position> reversed(positions.rbegin(), positions.rend());
+    auto reversed_cursors = clang::get_cursors(tu, reversed);
+    for(std::size_t i = 0; i < cursors.size(); i++)
+    {
+        CHECK(reversed_cursors[cursors.size() - 1 - i].equal_cursors(cursors[i]));
+    }
+
+    clang::cursor_index index{tu, f};
+    CHECK(index.size() > 0);
+    auto indexed = index.get_cursors(offsets);
+    for(std::size_t i = 0; i < cursors.size(); i++)
+    {
+        CHECK(indexed[i].equal_cursors(cursors[i]));
+    }
+
+    // Both agree on every offset of the file
+    std::vector<unsigned> all;
+    std::vector<clang::cursor_position> all_positions;
+    for(unsigned offset = 0; offset < get_offset(24, 1); offset++)
+    {
+        all.push_back(offset);
+        all_positions.push_back({f.self, offset});
+    }
+    auto from_index = index.get_cursors(all);
+    auto from_batch = clang::get_cursors(tu, all_positions);
+    for(std::size_t i = 0; i < all.size(); i++)
+    {
+        CHECK(from_index[i].equal_cursors(from_batch[i]));
+    }
+}
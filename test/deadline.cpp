@@ -0,0 +1,86 @@
+#include <clangpp/deadline.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+    std::string file = dir + "call_graph_example.cpp";
+    clang::parse_job job{dir, file, {"clang", file}};
+
+    clang::deadline_parser parser;
+
+    // A generous budget gets the full parse
+    auto full = parser.parse(job, std::chrono::seconds(60));
+    CHECK(full.tu.has_value());
+    CHECK(full.profile == clang::parse_profile::full);
+    CHECK(!full.degraded);
+    CHECK(full.tu->get_translation_unit_cursor().get_kind() == CXCursor_TranslationUnit);
+
+    // With no budget every profile starts at once, and whichever finishes
+    // first is still usable
+    auto rushed = parser.parse(job, std::chrono::milliseconds(0));
+    CHECK(rushed.tu.has_value());
+    CHECK(rushed.degraded == (rushed.profile != clang::parse_profile::full));
+
+    auto single = parser.parse(job, std::chrono::milliseconds(0), {clang::parse_profile::lexical_only});
+    CHECK(single.tu.has_value());
+    CHECK(single.profile == clang::parse_profile::lexical_only);
+    CHECK(!single.degraded);
+
+    // When every profile fails, the error of the richest one is reported.
+    // Each profile starts as soon as the one before it failed, rather than
+    // when its share of the budget runs out.
+    clang::parse_job missing{dir, dir + "missing.cpp", {"clang", dir + "missing.cpp"}};
+    auto failed_start = std::chrono::steady_clock::now();
+    auto failed = parser.parse(missing, std::chrono::seconds(60));
+    CHECK(std::chrono::steady_clock::now() - failed_start < std::chrono::seconds(20));
+    CHECK(!failed.tu);
+    CHECK(failed.profile == clang::parse_profile::full);
+
+    auto none = parser.parse(job, std::chrono::seconds(1), {});
+    CHECK(none.tu.error() == CXError_InvalidArguments);
+
+    // The full parse has to read a header with hundreds of thousands of
+    // functions, which the lexical parse never opens, so it always falls
+    // back
+    char buffer[4096];
+    CHECK(::getcwd(buffer, sizeof(buffer)) != nullptr);
+    std::string header = std::string(buffer) + "/test-deadline.hpp";
+    std::string slow_file = std::string(buffer) + "/test-deadline.cpp";
+    {
+        std::ofstream os(header);
+        for(int i = 0; i < 300000; i++) os << "inline int f" << i << "(int x) { return x * " << i << " + f" << (i / 2) << "(x - 1); }\n";
+        std::ofstream main_os(slow_file);
+        main_os << "#include \"test-deadline.hpp\"\nint main() { return 0; }\n";
+    }
+    clang::parse_job slow{buffer, slow_file, {"clang", slow_file}};
+    auto fallback = parser.parse(slow, std::chrono::milliseconds(20), {clang::parse_profile::full, clang::parse_profile::lexical_only});
+    CHECK(fallback.tu.has_value());
+    CHECK(fallback.profile == clang::parse_profile::lexical_only);
+    CHECK(fallback.degraded);
+    CHECK(fallback.owner != nullptr);
+    CHECK(fallback.tu->get_translation_unit_cursor().get_kind() == CXCursor_TranslationUnit);
+    // The full parse is still going, and is released once it finishes
+    CHECK(parser.get_running() == 1);
+    while(parser.get_running() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // The translation unit keeps its index, so it can outlive the parser,
+    // whose destructor does not wait for parses that lost
+    clang::deadline_result kept = [&]
+    {
+        clang::deadline_parser scoped;
+        return scoped.parse(job, std::chrono::seconds(60));
+    }();
+    CHECK(kept.tu.has_value());
+    CHECK(kept.tu->get_translation_unit_cursor().get_kind() == CXCursor_TranslationUnit);
+    std::remove(header.c_str());
+    std::remove(slow_file.c_str());
+}
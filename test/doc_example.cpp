@@ -0,0 +1,17 @@
+
+/// Adds two numbers.
+/// \param x The first number
+/// \param y The second number
+/// \returns The sum
+int add(int x, int y);
+
+/**
+ * \brief A box of values
+ * \tparam T The value type
+ * \code
+ * box<int> b;
+ * \endcode
+ */
+template<class T>
+struct box
+{};
@@ -0,0 +1,48 @@
+#include <clangpp/documentation.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(dir + "doc_example.cpp", {"-std=c++11"});
+    std::vector<clang::doc_record> records;
+    clang::extract_docs(tu.get_translation_unit_cursor(), [&](const clang::doc_record& r)
+    {
+        records.push_back(r);
+    });
+    CHECK(records.size() == 2);
+
+    auto&& add = records[0];
+    CHECK(add.kind == CXCursor_FunctionDecl);
+    CHECK(add.fields.size() == 4);
+    CHECK(add.fields[0].kind == clang::doc_field::brief);
+    CHECK(std::string(add.text(add.fields[0])).find("Adds two numbers.") != std::string::npos);
+    CHECK(add.fields[1].kind == clang::doc_field::param);
+    CHECK(std::string(add.name(add.fields[1])) == "x");
+    CHECK(std::string(add.name(add.fields[2])) == "y");
+    CHECK(add.fields[3].kind == clang::doc_field::returns);
+
+    auto&& box = records[1];
+    CHECK(box.kind == CXCursor_ClassTemplate);
+    CHECK(box.fields[0].kind == clang::doc_field::brief);
+    CHECK(std::any_of(box.fields.begin(), box.fields.end(), [&](const clang::doc_record::field& f)
+    {
+        return f.kind == clang::doc_field::tparam && std::string(box.name(f)) == "T";
+    }));
+    CHECK(std::any_of(box.fields.begin(), box.fields.end(), [&](const clang::doc_record::field& f)
+    {
+        return f.kind == clang::doc_field::verbatim && std::string(box.text(f)).find("box<int> b;") != std::string::npos;
+    }));
+
+    std::stringstream ss;
+    clang::json_doc_writer writer{ss};
+    writer(add);
+    CHECK(ss.str().find("\"field\":\"param\",\"name\":\"x\"") != std::string::npos);
+}
@@ -0,0 +1,104 @@
+#include <clangpp/fix_its.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream is(path);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    return ss.str();
+}
+
+void write_file(const std::string& path, const std::string& contents)
+{
+    std::ofstream os(path);
+    os << contents;
+}
+
+int main() {
+    // Missing semicolons after the struct and the variable
+    std::string path = "test-fix-its.cpp";
+    write_file(path, "struct point { int x; }\nint y = 1\nint z;\n");
+
+    clang::parse_job job{"", path, {"clang", path}};
+    auto fixes = clang::collect_fix_its({job, job});
+    // The same edits reported by both jobs are kept once
+    CHECK(fixes.files.size() == 1);
+    CHECK(fixes.size() == 2);
+
+    auto result = fixes.apply();
+    CHECK(result.files == 1);
+    CHECK(result.edits == 2);
+    CHECK(result.conflicts.empty());
+    CHECK(result.failed.empty());
+    CHECK(read_file(path) == "struct point { int x; };\nint y = 1;\nint z;\n");
+
+    // Overlapping edits keep the first one
+    write_file(path, "0123456789");
+    clang::fix_it_set edits;
+    edits.add(path, {2, 3, "abc"});
+    edits.add(path, {4, 2, "xy"});
+    edits.add(path, {8, 0, "-"});
+    edits.add(path, {8, 0, "+"});
+    edits.add(path, {8, 0, "+"});
+    result = edits.apply(1, 4);
+    CHECK(result.edits == 2);
+    CHECK(result.conflicts.size() == 2);
+    CHECK(read_file(path) == "01abc567+89");
+
+    // Files that are shorter than an edit are left alone
+    clang::fix_it_set past_end;
+    past_end.add(path, {100, 1, ""});
+    result = past_end.apply();
+    CHECK(result.failed.size() == 1);
+    CHECK(read_file(path) == "01abc567+89");
+
+    // The mode of the file is kept, and a symlink stays a link to the
+    // rewritten file
+    std::string link = "test-fix-its-link.cpp";
+    std::remove(link.c_str());
+    CHECK(::chmod(path.c_str(), 0640) == 0);
+    CHECK(::symlink(path.c_str(), link.c_str()) == 0);
+    clang::fix_it_set through_link;
+    through_link.add(link, {0, 2, "ab"});
+    result = through_link.apply();
+    CHECK(result.failed.empty());
+    CHECK(read_file(path) == "ababc567+89");
+    struct stat st;
+    CHECK(::lstat(link.c_str(), &st) == 0);
+    CHECK(S_ISLNK(st.st_mode));
+    CHECK(::stat(path.c_str(), &st) == 0);
+    CHECK((st.st_mode & 07777) == 0640);
+    std::remove(link.c_str());
+    std::remove(path.c_str());
+
+    // A header reached through two include paths is one file, so its edit
+    // is kept once and applied once
+    std::string include = "test-fix-its-include";
+    std::string header = include + "/test-fix-its.hpp";
+    std::string a = "test-fix-its-a.cpp";
+    std::string b = "test-fix-its-b.cpp";
+    ::mkdir(include.c_str(), 0755);
+    write_file(header, "struct point { int x; }\n");
+    write_file(a, "#include \"test-fix-its.hpp\"\nint a;\n");
+    write_file(b, "#include \"test-fix-its.hpp\"\nint b;\n");
+    clang::parse_job job_a{"", a, {"clang", "-I" + include, a}};
+    clang::parse_job job_b{"", b, {"clang", "-I./" + include + "/../" + include, b}};
+    auto header_fixes = clang::collect_fix_its({job_a, job_b});
+    CHECK(header_fixes.files.size() == 1);
+    CHECK(header_fixes.size() == 1);
+    CHECK(header_fixes.get_edits(header).size() == 1);
+    CHECK(header_fixes.get_edits("./" + header).size() == 1);
+    result = header_fixes.apply();
+    CHECK(result.files == 1);
+    CHECK(result.edits == 1);
+    CHECK(read_file(header) == "struct point { int x; };\n");
+    for(auto&& f:{header, a, b}) std::remove(f.c_str());
+    ::rmdir(include.c_str());
+}
@@ -0,0 +1,6 @@
+#include "shared.hpp"
+
+int a()
+{
+    return get_value(shared{1});
+}
@@ -0,0 +1,6 @@
+#include "shared.hpp"
+
+int b()
+{
+    return get_value(shared{2});
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+struct shared
+{
+    int value;
+};
+
+inline int get_value(shared s)
+{
+    return s.value;
+}
@@ -0,0 +1,64 @@
+#include <clangpp/header_registry.hpp>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+std::map<std::string, int> index_declarations(const std::vector<clang::parse_job>& jobs, clang::header_registry& registry)
+{
+    std::map<std::string, int> result;
+    std::mutex m;
+    clang::parallel_options opts;
+    opts.threads = 4;
+    auto failures = clang::parallel_index(jobs, [&](const clang::parse_job&, const CXIdxDeclInfo * info)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        result[info->entityInfo->name]++;
+    }, [](const clang::parse_job&, const CXIdxEntityRefInfo *) {}, registry, opts);
+    CHECK(failures == 0);
+    return result;
+}
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1) + "header_dedup/";
+    std::vector<clang::parse_job> jobs;
+    for(int i = 0; i < 4; i++)
+    {
+        for(std::string name:{"a.cpp", "b.cpp"}) jobs.push_back({dir, dir + name, {"clang++", "-std=c++14", dir + name}});
+    }
+
+    clang::header_registry registry;
+    auto decls = index_declarations(jobs, registry);
+    // The main files are indexed every time, the header only once
+    CHECK(decls["a"] == 4);
+    CHECK(decls["b"] == 4);
+    CHECK(decls["shared"] == 1);
+    CHECK(decls["value"] == 1);
+    CHECK(decls["get_value"] == 1);
+    CHECK(registry.size() == 1);
+    CHECK(registry.skipped > 0);
+
+    // A different macro context indexes the header again
+    jobs.push_back({dir, dir + "a.cpp", {"clang++", "-std=c++14", "-DOTHER", dir + "a.cpp"}});
+    decls = index_declarations(jobs, registry);
+    CHECK(decls["shared"] == 1);
+    CHECK(decls["a"] == 5);
+    CHECK(registry.size() == 2);
+    CHECK(registry.released == 0);
+
+    // Released claims are counted, so a caller knows to index again
+    clang::header_registry released;
+    clang::header_key k{};
+    k.id.data[0] = 1;
+    CHECK(released.claim(k));
+    CHECK(!released.claim(k));
+    released.release({k, k});
+    CHECK(released.released == 1);
+    CHECK(released.claim(k));
+
+    CHECK(clang::get_macro_context(jobs[0]) == clang::get_macro_context(jobs[2]));
+    CHECK(clang::get_macro_context(jobs[0]) != clang::get_macro_context(jobs.back()));
+}
@@ -0,0 +1,17 @@
+#define SQUARE(x) ((x) * (x))
+
+namespace ns {
+
+// A point
+struct point
+{
+    int x;
+    static int count();
+};
+
+int area(const point& p, int scale)
+{
+    return SQUARE(p.x) * scale;
+}
+
+}
@@ -0,0 +1,51 @@
+#include <clangpp/highlighting.hpp>
+#include <clangpp/index.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+bool has_span(const std::vector<clang::highlight_span>& spans, clang::highlight_kind kind, std::uint8_t modifiers=0)
+{
+    return std::any_of(spans.begin(), spans.end(), [&](const clang::highlight_span& s)
+    {
+        return s.kind == kind && (s.modifiers & modifiers) == modifiers;
+    });
+}
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+    std::string file = dir + "highlight_example.cpp";
+
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(file, clang::parse_profile::editing);
+    clang::highlighter h;
+    auto spans = h.highlight(tu, file);
+    CHECK(std::is_sorted(spans.begin(), spans.end(), [](const clang::highlight_span& x, const clang::highlight_span& y)
+    {
+        return x.offset < y.offset;
+    }));
+    CHECK(has_span(spans, clang::highlight_kind::keyword));
+    CHECK(has_span(spans, clang::highlight_kind::macro));
+    CHECK(has_span(spans, clang::highlight_kind::namespace_, clang::highlight_declaration));
+    CHECK(has_span(spans, clang::highlight_kind::type, clang::highlight_definition));
+    CHECK(has_span(spans, clang::highlight_kind::field));
+    CHECK(has_span(spans, clang::highlight_kind::method, clang::highlight_static));
+    CHECK(has_span(spans, clang::highlight_kind::parameter, clang::highlight_readonly));
+    CHECK(has_span(spans, clang::highlight_kind::function, clang::highlight_definition));
+
+    // Unchanged tokens return the same spans
+    auto again = h.highlight(tu, file);
+    CHECK(again.size() == spans.size());
+
+    // Only the body of area is highlighted
+    auto visible = h.highlight(tu, file, 14, 14);
+    CHECK(!visible.empty());
+    CHECK(visible.size() < spans.size());
+    CHECK(has_span(visible, clang::highlight_kind::parameter));
+    CHECK(!has_span(visible, clang::highlight_kind::namespace_));
+
+    CHECK(h.highlight(tu, "missing.cpp").empty());
+}
@@ -0,0 +1,124 @@
+#include <clangpp/incremental.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <utime.h>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+void set_time(const std::string& path, time_t time)
+{
+    utimbuf times{time, time};
+    CHECK(::utime(path.c_str(), &times) == 0);
+}
+
+// The modification time is set explicitly, since a test runs well within
+// the resolution of file times
+void write_file(const std::string& path, const std::string& contents, time_t time)
+{
+    {
+        std::ofstream os(path);
+        os << contents;
+    }
+    set_time(path, time);
+}
+
+std::set<std::string> refresh(clang::incremental_index& index, const std::vector<clang::parse_job>& jobs)
+{
+    std::set<std::string> result;
+    auto failures = index.refresh(jobs, [&](const clang::parse_job& job, clang::translation_unit&)
+    {
+        result.insert(job.filename);
+    });
+    CHECK(failures == 0);
+    return result;
+}
+
+int main() {
+    char buffer[4096];
+    CHECK(::getcwd(buffer, sizeof(buffer)) != nullptr);
+    std::string dir = buffer;
+    auto header = dir + "/test-incremental.hpp";
+    auto a = dir + "/test-incremental-a.cpp";
+    auto b = dir + "/test-incremental-b.cpp";
+    auto saved = dir + "/test-incremental.txt";
+    time_t now = std::time(nullptr);
+    write_file(header, "int shared();\n", now - 100);
+    write_file(a, "#include \"test-incremental.hpp\"\nint a() { return shared(); }\n", now - 100);
+    write_file(b, "#include \"test-incremental.hpp\"\nint b() { return shared(); }\n", now - 100);
+    std::vector<clang::parse_job> jobs;
+    for(auto&& f:{a, b}) jobs.push_back({dir, f, {"clang++", f}});
+
+    clang::incremental_index index;
+    CHECK(refresh(index, jobs) == (std::set<std::string>{a, b}));
+    CHECK(index.records.size() == 2);
+    // The main file and the header, each once
+    CHECK(index.records[a].files.size() == 2);
+    CHECK(refresh(index, jobs).empty());
+
+    // Touched but not modified
+    set_time(header, now - 50);
+    CHECK(refresh(index, jobs).empty());
+
+    // A modified header is stale for every translation unit that includes it
+    write_file(header, "int shared();\nint other();\n", now - 40);
+    CHECK(refresh(index, jobs) == (std::set<std::string>{a, b}));
+    CHECK(refresh(index, jobs).empty());
+
+    // A translation unit that recorded the header before its last change is
+    // stale, even after one that recorded it since was found up to date
+    auto before = index.records[a];
+    write_file(header, "int shared();\n", now - 30);
+    CHECK(refresh(index, jobs) == (std::set<std::string>{a, b}));
+    index.records[a] = before;
+    CHECK(refresh(index, {jobs[1], jobs[0]}) == (std::set<std::string>{a}));
+
+    // A different command line
+    auto changed = jobs;
+    changed[1].args.push_back("-DCHANGED");
+    CHECK(refresh(index, changed) == (std::set<std::string>{b}));
+    CHECK(refresh(index, changed).empty());
+
+    // Saved and loaded, nothing is stale
+    index.save(saved);
+    clang::incremental_index loaded;
+    loaded.load(saved);
+    CHECK(loaded.records.size() == index.records.size());
+    for(auto&& p:index.records)
+    {
+        auto&& x = p.second;
+        auto&& y = loaded.records[p.first];
+        CHECK(x.command_hash == y.command_hash);
+        CHECK(x.files.size() == y.files.size());
+        for(std::size_t i = 0; i < x.files.size(); i++)
+        {
+            CHECK(x.files[i].name == y.files[i].name);
+            CHECK(x.files[i].time == y.files[i].time);
+            CHECK(x.files[i].hash == y.files[i].hash);
+            CHECK(std::equal(std::begin(x.files[i].id.data), std::end(x.files[i].id.data), std::begin(y.files[i].id.data)));
+        }
+    }
+    CHECK(refresh(loaded, changed).empty());
+    write_file(header, "int shared();\nint third();\n", now - 10);
+    CHECK(refresh(loaded, changed) == (std::set<std::string>{a, b}));
+
+    // The hash of a file is read once per modification time
+    clang::detail::file_hash_cache cache;
+    auto hash = cache.get(header, now - 10);
+    CHECK(hash == clang::detail::hash_file_contents(header));
+    write_file(header, "int shared();\n", now - 10);
+    CHECK(cache.get(header, now - 10) == hash);
+    CHECK(cache.get(header, now - 5) == clang::detail::hash_file_contents(header));
+    CHECK(cache.get(header, now - 5) != hash);
+
+    // A missing file leaves the index empty
+    loaded.load(dir + "/test-incremental-missing.txt");
+    CHECK(loaded.records.empty());
+
+    for(auto&& f:{header, a, b, saved}) std::remove(f.c_str());
+}
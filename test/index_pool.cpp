@@ -0,0 +1,49 @@
+#include <clangpp/index_pool.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    // The same flags as index(0, 0)
+    clang::index_options defaults;
+    CHECK(!defaults.exclude_declarations_from_pch);
+    CHECK(!defaults.display_diagnostics);
+
+    clang::index_pool pool;
+    CHECK(pool.size() == 0);
+    auto * main_index = &pool.get();
+    CHECK(&pool.get() == main_index);
+    CHECK(pool.size() == 1);
+
+    std::vector<clang::index*> others(4, nullptr);
+    std::vector<std::thread> threads;
+    // Every thread stays alive until all of them have their index, so no
+    // thread id is reused
+    std::atomic<std::size_t> ready{0};
+    for(std::size_t i = 0; i < others.size(); i++)
+    {
+        threads.emplace_back([&, i]
+        {
+            others[i] = &pool.get();
+            CHECK(&pool.get() == others[i]);
+            ready++;
+            while(ready < others.size()) std::this_thread::yield();
+        });
+    }
+    for(auto&& t:threads) t.join();
+    CHECK(pool.size() == 5);
+    for(std::size_t i = 0; i < others.size(); i++)
+    {
+        CHECK(others[i] != main_index);
+        for(std::size_t j = 0; j < i; j++) CHECK(others[i] != others[j]);
+    }
+    CHECK(&pool.get() == main_index);
+
+    // Another pool does not reuse the index cached on this thread
+    clang::index_pool other_pool;
+    CHECK(&other_pool.get() != main_index);
+    CHECK(&pool.get() == main_index);
+    CHECK(other_pool.size() == 1);
+}
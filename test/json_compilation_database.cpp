@@ -0,0 +1,65 @@
+#include <clangpp/json_compilation_database.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+std::vector<std::string> get_args(clang::json_compilation_database::command cc)
+{
+    std::vector<std::string> result;
+    for(auto arg:cc.get_args()) result.push_back(arg);
+    return result;
+}
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+
+    clang::json_compilation_database db{dir + "json_database"};
+    CHECK(db.size() == 4);
+
+    auto a = db.get_compile_commands("/work/src/a.cpp");
+    CHECK(a.size() == 2);
+    CHECK(std::string((*a.begin()).get_directory()) == "/work/build");
+    CHECK(std::string((*a.begin()).get_filename()) == "../src/a.cpp");
+    CHECK(get_args(*a.begin()) == std::vector<std::string>{"clang++", "-std=c++14", "-Iinclude", "-c", "../src/a.cpp"});
+    CHECK(get_args(*std::next(a.begin())) == std::vector<std::string>{"clang++", "-std=c++14", "-DTEST", "-c", "../src/a.cpp"});
+    CHECK(db["/work/build/../src/./a.cpp"].size() == 2);
+
+    // Arguments are interned, so equal arguments share storage
+    CHECK((*a.begin()).get_arg(1) == (*std::next(a.begin())).get_arg(1));
+
+    auto b = db.get_compile_commands("/work/src/b.cpp");
+    CHECK(b.size() == 1);
+    CHECK(get_args(*b.begin()) == std::vector<std::string>{"clang++", "-std=c++14", "-DNAME=two words", "-DPATH=a b", "-Iinclude", "-c", "/work/src/b.cpp"});
+
+    CHECK(db.get_compile_commands("/work/build/gen/\xc3\xa9t\xc3\xa9.cpp").size() == 1);
+    CHECK(db.get_compile_commands("/work/src/missing.cpp").size() == 0);
+    CHECK(db.get_compile_commands("clang++").size() == 0);
+
+    auto jobs = clang::get_parse_jobs(db);
+    CHECK(jobs.size() == 4);
+    CHECK(jobs[1].filename == "/work/src/b.cpp");
+    CHECK(jobs[1].args.size() == 7);
+
+    std::string text = "[{\"directory\": \"/d\", \"file\": \"f.c\", \"command\": \"cc -c f.c\", \"extra\": {\"x\": [1, true, null]}}]";
+    auto small = clang::json_compilation_database::from_buffer(text.data(), text.size());
+    CHECK(small.get_compile_commands("/d/f.c").size() == 1);
+
+    for(std::string bad:{"[{\"file\": \"f.c\"}]", "[{\"directory\": \"/d\", \"file\": \"f.c\"", "{}"})
+    {
+        bool thrown = false;
+        try
+        {
+            clang::json_compilation_database::from_buffer(bad.data(), bad.size());
+        }
+        catch(const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+}
@@ -0,0 +1,6 @@
+#include <example_module.h>
+
+int main()
+{
+    return module_function();
+}
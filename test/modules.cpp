@@ -0,0 +1,58 @@
+#include <clangpp/modules.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <ftw.h>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+void remove_tree(const std::string& path)
+{
+    nftw(path.c_str(), [](const char * name, const struct stat *, int, FTW *)
+    {
+        return std::remove(name);
+    }, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+    std::string file = dir + "module_example.cpp";
+
+    clang::module_cache cache{"test-module-cache"};
+    auto args = cache.get_args();
+    CHECK(args.size() == 4);
+    CHECK(args[1] == "-fmodules-cache-path=test-module-cache");
+
+    clang::parse_job job{"", file, {"clang", "-I" + dir + "modules", file}};
+    CHECK(cache.add_args(std::vector<clang::parse_job>{job})[0].args[1] == "-fmodules");
+
+    clang::parallel_options opts;
+    opts.threads = 1;
+    clang::module_stats stats;
+    std::vector<clang::module_report> reports;
+    auto collect = [&](const clang::parse_job& j, clang::translation_unit&, const clang::module_report& r)
+    {
+        CHECK(j.args.size() == 3);
+        reports.push_back(r);
+    };
+    // The cache is shared, so the second parse reuses the module built by the first
+    CHECK(clang::parallel_parse({job}, collect, cache, stats, opts) == 0);
+    CHECK(clang::parallel_parse({job}, collect, cache, stats, opts) == 0);
+    CHECK(reports.size() == 2);
+    CHECK(reports[0].modules.size() == 1);
+    CHECK(reports[0].modules[0].name == "example_module");
+    CHECK(reports[1].modules.size() == 1);
+    CHECK(reports[1].hits() == 1);
+    CHECK(reports[1].modules[0].ast_file == reports[0].modules[0].ast_file);
+    CHECK(stats.hits + stats.rebuilds == 2);
+    CHECK(stats.hits >= 1);
+
+    // A pool from the caller is used for the parses
+    clang::index_pool pool;
+    CHECK(clang::parallel_parse({job}, collect, cache, stats, pool, opts) == 0);
+    CHECK(pool.size() == 1);
+    CHECK(reports.size() == 3);
+    CHECK(reports[2].hits() == 1);
+    remove_tree(cache.path);
+}
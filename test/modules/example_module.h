@@ -0,0 +1 @@
+int module_function();
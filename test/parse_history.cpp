@@ -0,0 +1,56 @@
+#include <clangpp/parallel.hpp>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+    auto make_job = [&](std::string name)
+    {
+        return clang::parse_job{dir, name, {"clang++", name}};
+    };
+    std::vector<clang::parse_job> jobs = {make_job("example.cpp"), make_job("call_graph_example.cpp"), make_job("missing.cpp")};
+
+    // Without a history the biggest file goes first, and a missing file last
+    clang::parse_history history;
+    CHECK(history.get_schedule(jobs) == std::vector<std::size_t>{1, 0, 2});
+
+    // Recorded times take precedence over file sizes
+    history.record(jobs[0], 2.0);
+    history.record(jobs[1], 1.0);
+    CHECK(history.size() == 2);
+    CHECK(history.get_schedule(jobs) == std::vector<std::size_t>{0, 1, 2});
+    history.record(jobs[1], 5.0);
+    CHECK(history.get_schedule(jobs) == std::vector<std::size_t>{1, 0, 2});
+    auto costs = history.estimate(jobs);
+    CHECK(costs[1] == 3.0);
+
+    // Unseen jobs are estimated from the rate of the recorded ones
+    auto other = make_job("type_example.cpp");
+    other.args.push_back("-DOTHER");
+    CHECK(history.estimate({other})[0] > 0);
+
+    std::string path = "parse_history_test.txt";
+    CHECK(history.save(path));
+    clang::parse_history loaded;
+    CHECK(loaded.load(path));
+    CHECK(loaded.size() == 2);
+    CHECK(loaded.get_schedule(jobs) == history.get_schedule(jobs));
+    std::remove(path.c_str());
+    CHECK(!loaded.load(path));
+
+    // Parsing records the time of every job that parsed
+    clang::parse_history parsed;
+    clang::parallel_options opts;
+    opts.threads = 2;
+    opts.history = &parsed;
+    std::atomic<std::size_t> n{0};
+    auto failures = clang::parallel_parse(jobs, [&](const clang::parse_job&, clang::translation_unit&) { n++; }, opts);
+    CHECK(failures == 1);
+    CHECK(n == 2);
+    CHECK(parsed.size() == 2);
+}
@@ -0,0 +1,52 @@
+#include <clangpp/pipeline.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+    std::string file = dir + "call_graph_example.cpp";
+    clang::parse_job job{dir, file, {"clang", file}};
+    std::vector<clang::parse_job> jobs(20, job);
+    jobs.push_back({dir, dir + "missing.cpp", {"clang", dir + "missing.cpp"}});
+
+    clang::pipeline_options opts;
+    opts.threads = 4;
+    opts.queue_size = 2;
+    std::size_t consumed = 0;
+    // Results only need to be movable
+    auto failures = clang::pipeline_parse(jobs, [](const clang::parse_job&, clang::translation_unit& tu)
+    {
+        std::unique_ptr<std::size_t> n{new std::size_t(0)};
+        for(auto c:tu.get_translation_unit_cursor().children())
+        {
+            if (c.get_kind() == CXCursor_FunctionDecl) ++*n;
+        }
+        return n;
+    }, [&](const clang::parse_job& j, std::unique_ptr<std::size_t> n)
+    {
+        CHECK(j.filename == file);
+        CHECK(*n == 4);
+        consumed++;
+    }, opts);
+    CHECK(consumed == 20);
+    CHECK(failures == 1);
+
+    // An exception from consume stops the pipeline and reaches the caller
+    bool thrown = false;
+    try
+    {
+        clang::pipeline_parse(jobs, [](const clang::parse_job&, clang::translation_unit&) { return 0; }, [](const clang::parse_job&, int)
+        {
+            throw std::runtime_error("stop");
+        }, opts);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
@@ -0,0 +1,53 @@
+#include <clangpp/process_pool.hpp>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+    auto source = dir + "call_graph_example.cpp";
+    // The last argument tells the worker what to do with the job
+    std::vector<clang::parse_job> jobs;
+    for(std::string action:{"-DOK", "-DCRASH", "-DOK", "-DFAIL", "-DOK"}) jobs.push_back({dir, source, {"clang", source, action}});
+
+    std::vector<std::string> results;
+    clang::process_options opts;
+    // A single worker takes the jobs in order, so the crash is replaced
+    opts.workers = 1;
+    auto r = clang::process_parse(jobs, [](const clang::parse_job& job, clang::translation_unit& tu, std::string& buffer)
+    {
+        if (job.args.back() == "-DCRASH") std::abort();
+        if (job.args.back() == "-DFAIL") throw std::runtime_error("extract failed");
+        buffer = tu.get_translation_unit_spelling().to_std_string();
+    }, [&](const clang::parse_job& job, const char * data, std::size_t size)
+    {
+        CHECK(job.args.back() == "-DOK");
+        results.emplace_back(data, size);
+    }, opts);
+    CHECK(results.size() == 3);
+    for(auto&& s:results) CHECK(s.find("call_graph_example.cpp") != std::string::npos);
+    CHECK(r.crashed == std::vector<std::size_t>{1});
+    CHECK(r.restarts == 1);
+    CHECK(r.failures == 2);
+
+    // Without a crash, no worker is replaced
+    jobs.erase(jobs.begin() + 1);
+    opts.workers = 2;
+    results.clear();
+    r = clang::process_parse(jobs, [](const clang::parse_job& job, clang::translation_unit&, std::string& buffer)
+    {
+        if (job.args.back() == "-DFAIL") throw std::runtime_error("extract failed");
+        buffer = "ok";
+    }, [&](const clang::parse_job&, const char * data, std::size_t size)
+    {
+        results.emplace_back(data, size);
+    }, opts);
+    CHECK(results.size() == 3);
+    CHECK(r.crashed.empty());
+    CHECK(r.restarts == 0);
+    CHECK(r.failures == 1);
+}
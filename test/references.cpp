@@ -0,0 +1,92 @@
+#include <clangpp/references.hpp>
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+typedef std::tuple<std::string, unsigned, unsigned, bool> found;
+
+std::vector<found> find_all(const std::vector<clang::parse_job>& jobs, const char * usr)
+{
+    std::vector<found> result;
+    clang::parallel_options opts;
+    opts.threads = 2;
+    auto failures = clang::find_references(jobs, usr, [&](const clang::reference_location& r)
+    {
+        auto name = r.file.substr(r.file.rfind('/') + 1);
+        result.emplace_back(name, r.line, r.column, r.is_declaration);
+        return CXVisit_Continue;
+    }, opts);
+    CHECK(failures == 0);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1) + "references/";
+    std::vector<clang::parse_job> jobs;
+    for(std::string name:{"a.cpp", "b.cpp"}) jobs.push_back({dir, dir + name, {"clang++", "-std=c++14", dir + name}});
+
+    // The declaration in the header is reported once, although both
+    // translation units include it
+    auto functions = find_all(jobs, "c:@F@scale#I#");
+    CHECK(functions.size() == 5);
+    CHECK(functions[0] == found("a.cpp", 3, 5, true));
+    CHECK(functions[1] == found("a.cpp", 10, 12, false));
+    CHECK(functions[2] == found("b.cpp", 6, 14, false));
+    CHECK(functions[3] == found("b.cpp", 7, 12, false));
+    CHECK(functions[4] == found("widget.hpp", 3, 5, true));
+
+    auto methods = find_all(jobs, "c:@S@widget@F@resize#I#");
+    CHECK(methods.size() == 3);
+    CHECK(methods[0] == found("a.cpp", 8, 14, true));
+    CHECK(methods[1] == found("b.cpp", 6, 7, false));
+    CHECK(methods[2] == found("widget.hpp", 8, 10, true));
+
+    CHECK(find_all(jobs, "c:@F@missing#").empty());
+
+    // The matcher computes the usr of a declaration once
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(dir + "a.cpp");
+    clang::cursor scale;
+    tu.get_translation_unit_cursor().visit_children([&](clang::cursor c, clang::cursor)
+    {
+        if (c.get_kind() != CXCursor_FunctionDecl || std::string(c.get_spelling().c_str()) != "scale") return CXChildVisit_Continue;
+        scale = c;
+        return CXChildVisit_Break;
+    });
+    CHECK(!scale.is_null());
+    clang::detail::usr_matcher match{"c:@F@scale#I#"};
+    auto&& first = match(scale);
+    CHECK(first.match);
+    CHECK(first.length == 5);
+    CHECK(&match(scale) == &first);
+    CHECK(match.cache.size() == 1);
+    CHECK(match.cache.begin()->second.size() == 1);
+
+    // Breaking from the callback stops the search
+    std::vector<clang::parse_job> many(8, jobs[1]);
+    std::size_t calls = 0;
+    clang::parallel_options opts;
+    opts.threads = 4;
+    clang::find_references(many, "c:@F@scale#I#", [&](const clang::reference_location&)
+    {
+        calls++;
+        return CXVisit_Break;
+    }, opts);
+    CHECK(calls == 1);
+
+    // So does setting the cancel flag
+    std::atomic<bool> cancel{true};
+    opts.cancel = &cancel;
+    calls = 0;
+    clang::find_references(many, "c:@F@scale#I#", [&](const clang::reference_location&)
+    {
+        calls++;
+        return CXVisit_Continue;
+    }, opts);
+    CHECK(calls == 0);
+}
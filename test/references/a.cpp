@@ -0,0 +1,11 @@
+#include "widget.hpp"
+
+int scale(int x)
+{
+    return x * 2;
+}
+
+void widget::resize(int n)
+{
+    size = scale(n);
+}
@@ -0,0 +1,8 @@
+#include "widget.hpp"
+
+int use()
+{
+    widget w{1};
+    w.resize(scale(2));
+    return scale(w.size);
+}
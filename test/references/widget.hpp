@@ -0,0 +1,9 @@
+#pragma once
+
+int scale(int x);
+
+struct widget
+{
+    int size;
+    void resize(int n);
+};
@@ -0,0 +1,59 @@
+#include <clangpp/snapshot.hpp>
+#include <clangpp/index.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(dir + "example.cpp");
+    std::string path = "test-snapshot.bin";
+    clang::write_snapshot(tu, path);
+
+    {
+        clang::snapshot_reader r{path};
+        CHECK(r.node_count() > 2);
+        CHECK(r.node(0).kind == CXCursor_TranslationUnit);
+        CHECK(r.node(0).parent == clang::snapshot_npos);
+        std::uint32_t foo = clang::snapshot_npos;
+        r.for_each_child(0, [&](std::uint32_t i, const clang::snapshot_node& n)
+        {
+            if (n.kind == CXCursor_StructDecl) foo = i;
+        });
+        CHECK(foo != clang::snapshot_npos);
+        CHECK(std::string(r.string(r.node(foo).spelling)) == "foo");
+        CHECK(std::string(r.string(r.file(r.node(foo).file).name)).find("example.cpp") != std::string::npos);
+        CHECK(r.node(foo).line == 2);
+        CHECK(r.node(foo).type != clang::snapshot_npos);
+        CHECK(std::string(r.string(r.type(r.node(foo).type).spelling)) == "foo");
+        std::uint32_t method = r.node(foo).first_child;
+        CHECK(method != clang::snapshot_npos);
+        CHECK(r.node(method).kind == CXCursor_CXXMethod);
+        CHECK(r.node(method).parent == foo);
+        CHECK(r.node(method).referenced == method);
+    }
+    std::remove(path.c_str());
+
+    // Types with the same spelling stay distinct
+    auto local_tu = idx.parse_translation_unit(dir + "snapshot_example.cpp");
+    clang::write_snapshot(local_tu, path);
+    {
+        clang::snapshot_reader r{path};
+        std::vector<std::uint32_t> local_types;
+        for(std::uint32_t i = 0; i < r.node_count(); i++)
+        {
+            if (r.node(i).kind == CXCursor_VarDecl) local_types.push_back(r.node(i).type);
+        }
+        CHECK(local_types.size() == 2);
+        CHECK(local_types[0] != local_types[1]);
+        CHECK(std::string(r.string(r.type(local_types[0]).spelling)) == std::string(r.string(r.type(local_types[1]).spelling)));
+        CHECK(r.type(local_types[0]).size == 1);
+        CHECK(r.type(local_types[1]).size == 32);
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,9 @@
+void small()
+{
+    struct node { char c; } n;
+}
+
+void large()
+{
+    struct node { double d[4]; } n;
+}
@@ -0,0 +1,33 @@
+#define CLANGPP_TRACE
+#include <clangpp.hpp>
+#include <sstream>
+#include <string>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(dir + "example.cpp");
+    int n = 0;
+    tu.get_translation_unit_cursor().visit_children([&](clang::cursor, clang::cursor)
+    {
+        n++;
+        return CXChildVisit_Recurse;
+    });
+    CHECK(n > 0);
+
+    auto counters = clang::trace::get_counters();
+    CHECK(counters["clang_parseTranslationUnit2"].calls == 1);
+    CHECK(counters["clang_visitChildren"].calls == 1);
+    CHECK(counters["clang_parseTranslationUnit2"].total > 0);
+
+    std::stringstream trace;
+    clang::trace::write_chrome_trace(trace);
+    CHECK(trace.str().find("\"name\":\"clang_visitChildren\",\"ph\":\"X\"") != std::string::npos);
+
+    clang::trace::reset();
+    CHECK(clang::trace::get_counters().empty());
+}
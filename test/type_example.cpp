@@ -0,0 +1,12 @@
+typedef int integer;
+using number = int;
+
+struct point
+{
+    int x;
+    integer y;
+    number z;
+};
+
+point origin;
+const point * corner;
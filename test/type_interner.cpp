@@ -0,0 +1,46 @@
+#include <clangpp/type_interner.hpp>
+#include <clangpp/index.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#define CHECK(...) if (!(__VA_ARGS__)) { printf("Failed: %s\n", #__VA_ARGS__); std::abort(); }
+
+int main() {
+    std::string dir = __FILE__;
+    dir = dir.substr(0, dir.rfind('/')+1);
+
+    clang::index idx{0, 0};
+    auto tu = idx.parse_translation_unit(dir + "type_example.cpp");
+    std::unordered_map<std::string, clang::type> types;
+    for(auto c:tu.get_translation_unit_cursor().descendants())
+    {
+        auto kind = c.get_kind();
+        if (kind == CXCursor_FieldDecl || kind == CXCursor_VarDecl) types.emplace(c.get_spelling().to_std_string(), c.get_type());
+    }
+    CHECK(types.size() == 5);
+
+    // Sugared types are distinct types, but share a canonical type
+    CHECK(types.at("x") != types.at("y"));
+    CHECK(types.at("x") == types.at("x"));
+    std::unordered_set<clang::type> unique;
+    for(auto&& p:types) unique.insert(p.second);
+    CHECK(unique.count(types.at("z")) == 1);
+
+    clang::type_interner interner{tu};
+    auto x = interner.intern(types.at("x"));
+    CHECK(interner.intern(types.at("y")) == x);
+    CHECK(interner.intern(types.at("z")) == x);
+    CHECK(std::string(interner.get_spelling(x)) == "int");
+    CHECK(interner.get_size_of(x) == sizeof(int));
+    CHECK(interner.get(x).kind == CXType_Int);
+
+    auto origin = interner.intern(types.at("origin"));
+    CHECK(origin != x);
+    CHECK(std::string(interner.get_spelling(origin)) == "point");
+    CHECK(interner.get_size_of(origin) == 3 * sizeof(int));
+    auto corner = interner.intern(types.at("corner"));
+    CHECK(interner.get(corner).kind == CXType_Pointer);
+    CHECK(interner.size() == 3);
+    CHECK(interner.get_type(x) == types.at("x").get_canonical_type());
+}